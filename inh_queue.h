@@ -0,0 +1,703 @@
+// (For more information, see the bottom of this file).
+
+#ifndef INH_INCLUDE_INH_QUEUE_H
+#define INH_INCLUDE_INH_QUEUE_H
+
+// --- Begin header code --- //
+
+#ifndef INH_QUEUE_NO_STDLIB
+#include <stdlib.h>
+#endif
+
+#ifndef INH_QUEUE_NO_STDBOOL
+#include <stdbool.h>
+#endif
+
+#include <stdalign.h>
+#include <stdatomic.h>
+
+#ifndef INH_QUEUE_DEF
+#ifdef INH_QUEUE_STATIC
+#define INH_QUEUE_DEF static
+#else
+#define INH_QUEUE_DEF extern
+#endif
+#endif
+
+// Indices written by different threads are kept this far apart, so that
+// they are not in the same cache line
+#ifndef INH_QUEUE_CACHE_LINE
+#define INH_QUEUE_CACHE_LINE 64
+#endif
+
+#ifdef INH_QUEUE_BLOCKING
+#include <pthread.h>
+
+/*
+ * Lets threads sleep until a queue changes. Threads that change the queue
+ * only lock it when another thread is waiting.
+ */
+typedef struct INH_queue_event {
+    atomic_uint waiters;
+    atomic_uint generation; // Counts the times waiting threads were woken
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} INH_queue_event;
+
+#define INH_QUEUE__EVENT_FIELDS \
+    alignas(INH_QUEUE_CACHE_LINE) INH_queue_event not_empty; \
+    alignas(INH_QUEUE_CACHE_LINE) INH_queue_event not_full;
+#else
+#define INH_QUEUE__EVENT_FIELDS
+#endif
+
+/*
+ * A fixed-size queue of pointers for one producer thread and one consumer
+ * thread. Every operation finishes in a fixed number of steps.
+ */
+typedef struct INH_spsc_queue {
+    // Written by the consumer
+    alignas(INH_QUEUE_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail; // The consumer's last look at tail
+    // Written by the producer
+    alignas(INH_QUEUE_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head; // The producer's last look at head
+    INH_QUEUE__EVENT_FIELDS
+    // Not changed after creation
+    alignas(INH_QUEUE_CACHE_LINE) size_t mask;
+    void * slots[];
+} INH_spsc_queue;
+
+/*
+ * A fixed-size queue of pointers for any number of producer and consumer
+ * threads (Dmitry Vyukov's bounded MPMC queue).
+ * Each cell has a sequence number that says whose turn it is to use it.
+ */
+typedef struct INH_mpmc_cell {
+    atomic_size_t sequence;
+    void * data;
+} INH_mpmc_cell;
+
+typedef struct INH_mpmc_queue {
+    alignas(INH_QUEUE_CACHE_LINE) atomic_size_t enqueue_pos;
+    alignas(INH_QUEUE_CACHE_LINE) atomic_size_t dequeue_pos;
+    INH_QUEUE__EVENT_FIELDS
+    // Not changed after creation
+    alignas(INH_QUEUE_CACHE_LINE) size_t mask;
+    INH_mpmc_cell cells[];
+} INH_mpmc_queue;
+
+INH_QUEUE_DEF INH_spsc_queue * spsc_queue_create (size_t capacity);
+
+INH_QUEUE_DEF void spsc_queue_destroy (INH_spsc_queue * queue);
+
+INH_QUEUE_DEF size_t spsc_queue_capacity (const INH_spsc_queue * queue);
+
+INH_QUEUE_DEF bool spsc_queue_push (INH_spsc_queue * queue, void * item);
+
+INH_QUEUE_DEF bool spsc_queue_pop (INH_spsc_queue * queue, void ** item);
+
+INH_QUEUE_DEF size_t spsc_queue_push_batch (INH_spsc_queue * queue, void * const items[], size_t count);
+
+INH_QUEUE_DEF size_t spsc_queue_pop_batch (INH_spsc_queue * queue, void * items[], size_t count);
+
+INH_QUEUE_DEF void spsc_queue_push_wait (INH_spsc_queue * queue, void * item);
+
+INH_QUEUE_DEF void * spsc_queue_pop_wait (INH_spsc_queue * queue);
+
+INH_QUEUE_DEF INH_mpmc_queue * mpmc_queue_create (size_t capacity);
+
+INH_QUEUE_DEF void mpmc_queue_destroy (INH_mpmc_queue * queue);
+
+INH_QUEUE_DEF size_t mpmc_queue_capacity (const INH_mpmc_queue * queue);
+
+INH_QUEUE_DEF bool mpmc_queue_push (INH_mpmc_queue * queue, void * item);
+
+INH_QUEUE_DEF bool mpmc_queue_pop (INH_mpmc_queue * queue, void ** item);
+
+INH_QUEUE_DEF size_t mpmc_queue_push_batch (INH_mpmc_queue * queue, void * const items[], size_t count);
+
+INH_QUEUE_DEF size_t mpmc_queue_pop_batch (INH_mpmc_queue * queue, void * items[], size_t count);
+
+INH_QUEUE_DEF void mpmc_queue_push_wait (INH_mpmc_queue * queue, void * item);
+
+INH_QUEUE_DEF void * mpmc_queue_pop_wait (INH_mpmc_queue * queue);
+
+// --- End header code --- //
+
+#endif // INH_INCLUDE_INH_QUEUE_H
+
+#ifdef INH_QUEUE_IMPLEMENTATION
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define INH_QUEUE__YIELD() sched_yield()
+#else
+#define INH_QUEUE__YIELD() ((void)0)
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define INH_QUEUE__PAUSE() _mm_pause()
+#else
+#define INH_QUEUE__PAUSE() ((void)0)
+#endif
+
+// How many times the _wait functions spin before yielding or sleeping
+#ifndef INH_QUEUE_SPINS
+#define INH_QUEUE_SPINS 64
+#endif
+
+/*
+ * Round a capacity up to a power of two, so indices wrap with a mask.
+ * Returns 0 if there is no power of two that big.
+ */
+static size_t queue__capacity (size_t capacity) {
+    size_t result = 2;
+    while (result < capacity) {
+        if (result > SIZE_MAX / 2) {
+            return 0;
+        }
+        result *= 2;
+    }
+    return result;
+}
+
+/*
+ * Allocate size bytes aligned to a cache line.
+ */
+static void * queue__alloc (size_t size) {
+    size = (size + INH_QUEUE_CACHE_LINE - 1) / INH_QUEUE_CACHE_LINE * INH_QUEUE_CACHE_LINE;
+    return aligned_alloc(INH_QUEUE_CACHE_LINE, size);
+}
+
+/*
+ * Wait a little before trying a full or empty queue again: spin at first,
+ * and then give up the processor.
+ * (With INH_QUEUE_BLOCKING, the _wait functions sleep instead of yielding.)
+ */
+static void queue__backoff (unsigned * spins) {
+    if (*spins < INH_QUEUE_SPINS) {
+        INH_QUEUE__PAUSE();
+        (*spins)++;
+    } else {
+        INH_QUEUE__YIELD();
+    }
+}
+
+#ifdef INH_QUEUE_BLOCKING
+
+static bool queue__event_init (INH_queue_event * event) {
+    atomic_init(&event->waiters, 0);
+    atomic_init(&event->generation, 0);
+    if (pthread_mutex_init(&event->lock, NULL) != 0) {
+        return false;
+    }
+    if (pthread_cond_init(&event->changed, NULL) != 0) {
+        pthread_mutex_destroy(&event->lock);
+        return false;
+    }
+    return true;
+}
+
+static void queue__event_destroy (INH_queue_event * event) {
+    pthread_cond_destroy(&event->changed);
+    pthread_mutex_destroy(&event->lock);
+}
+
+/*
+ * Start waiting for an event. The caller must try its operation again after
+ * this, and then either cancel or wait.
+ * Returns the generation to pass to queue__event_wait.
+ */
+static unsigned queue__event_prepare (INH_queue_event * event) {
+    atomic_fetch_add_explicit(&event->waiters, 1, memory_order_relaxed);
+    // Pairs with the fence in queue__event_notify: either the operation
+    // tried next sees the change, or the notifying thread sees this waiter
+    atomic_thread_fence(memory_order_seq_cst);
+    return atomic_load_explicit(&event->generation, memory_order_relaxed);
+}
+
+static void queue__event_cancel (INH_queue_event * event) {
+    atomic_fetch_sub_explicit(&event->waiters, 1, memory_order_relaxed);
+}
+
+/*
+ * Sleep until the event is notified after generation.
+ */
+static void queue__event_wait (INH_queue_event * event, unsigned generation) {
+    pthread_mutex_lock(&event->lock);
+    while (atomic_load_explicit(&event->generation, memory_order_relaxed) == generation) {
+        pthread_cond_wait(&event->changed, &event->lock);
+    }
+    pthread_mutex_unlock(&event->lock);
+    atomic_fetch_sub_explicit(&event->waiters, 1, memory_order_relaxed);
+}
+
+/*
+ * Wake the threads waiting for an event, if there are any.
+ */
+static void queue__event_notify (INH_queue_event * event) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&event->waiters, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&event->lock);
+        atomic_fetch_add_explicit(&event->generation, 1, memory_order_relaxed);
+        pthread_cond_broadcast(&event->changed);
+        pthread_mutex_unlock(&event->lock);
+    }
+}
+
+static bool queue__events_init (INH_queue_event * not_empty, INH_queue_event * not_full) {
+    if (!queue__event_init(not_empty)) {
+        return false;
+    }
+    if (!queue__event_init(not_full)) {
+        queue__event_destroy(not_empty);
+        return false;
+    }
+    return true;
+}
+
+#define INH_QUEUE__EVENTS_INIT(queue) queue__events_init(&(queue)->not_empty, &(queue)->not_full)
+#define INH_QUEUE__EVENTS_DESTROY(queue) (queue__event_destroy(&(queue)->not_empty), queue__event_destroy(&(queue)->not_full))
+#define INH_QUEUE__NOTIFY(queue, event) queue__event_notify(&(queue)->event)
+
+/*
+ * Once a _wait function has spun for a while, sleep until the queue changes
+ * instead of yielding. (try) is the operation being waited for.
+ */
+#define INH_QUEUE__WAIT(queue, event, spins, try) \
+    if ((spins) >= INH_QUEUE_SPINS) { \
+        unsigned generation = queue__event_prepare(&(queue)->event); \
+        if (try) { \
+            queue__event_cancel(&(queue)->event); \
+            break; \
+        } \
+        queue__event_wait(&(queue)->event, generation); \
+        continue; \
+    }
+
+#else
+
+#define INH_QUEUE__EVENTS_INIT(queue) true
+#define INH_QUEUE__EVENTS_DESTROY(queue) ((void)0)
+#define INH_QUEUE__NOTIFY(queue, event) ((void)0)
+#define INH_QUEUE__WAIT(queue, event, spins, try)
+
+#endif // INH_QUEUE_BLOCKING
+
+/*
+ * Create a queue for one producer and one consumer that holds at least
+ * capacity items. The capacity is rounded up to a power of two.
+ * Returns NULL if the capacity is too big or the queue could not be
+ * allocated.
+ */
+INH_spsc_queue * spsc_queue_create (size_t capacity) {
+    capacity = queue__capacity(capacity);
+    if (capacity == 0 || capacity > (SIZE_MAX - sizeof(INH_spsc_queue)) / sizeof(void *)) {
+        return NULL;
+    }
+    INH_spsc_queue * queue = queue__alloc(sizeof(*queue) + capacity * sizeof(void *));
+    if (queue == NULL) {
+        return queue;
+    }
+    if (!INH_QUEUE__EVENTS_INIT(queue)) {
+        free(queue);
+        return NULL;
+    }
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->cached_tail = 0;
+    queue->cached_head = 0;
+    queue->mask = capacity - 1;
+    return queue;
+}
+
+void spsc_queue_destroy (INH_spsc_queue * queue) {
+    INH_QUEUE__EVENTS_DESTROY(queue);
+    free(queue);
+}
+
+size_t spsc_queue_capacity (const INH_spsc_queue * queue) {
+    return queue->mask + 1;
+}
+
+/*
+ * Returns how many items the producer can push, looking at head again only
+ * if the last look does not show room for want items.
+ */
+static size_t spsc_queue__room (INH_spsc_queue * queue, size_t tail, size_t want) {
+    size_t capacity = queue->mask + 1;
+    size_t room = capacity - (tail - queue->cached_head);
+    if (room < want) {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        room = capacity - (tail - queue->cached_head);
+    }
+    return room;
+}
+
+/*
+ * Returns how many items the consumer can pop, looking at tail again only
+ * if the last look does not show want items.
+ */
+static size_t spsc_queue__ready (INH_spsc_queue * queue, size_t head, size_t want) {
+    size_t ready = queue->cached_tail - head;
+    if (ready < want) {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        ready = queue->cached_tail - head;
+    }
+    return ready;
+}
+
+/*
+ * Add an item to the queue. Only call this from the producer thread.
+ * Returns false if the queue is full.
+ */
+bool spsc_queue_push (INH_spsc_queue * queue, void * item) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (spsc_queue__room(queue, tail, 1) == 0) {
+        return false;
+    }
+    queue->slots[tail & queue->mask] = item;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    INH_QUEUE__NOTIFY(queue, not_empty);
+    return true;
+}
+
+/*
+ * Take the oldest item from the queue. Only call this from the consumer
+ * thread.
+ * Returns false if the queue is empty.
+ */
+bool spsc_queue_pop (INH_spsc_queue * queue, void ** item) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (spsc_queue__ready(queue, head, 1) == 0) {
+        return false;
+    }
+    *item = queue->slots[head & queue->mask];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    INH_QUEUE__NOTIFY(queue, not_full);
+    return true;
+}
+
+/*
+ * Add as many of count items to the queue as there is room for, and
+ * publish them to the consumer all at once.
+ * Returns the number of items added.
+ */
+size_t spsc_queue_push_batch (INH_spsc_queue * queue, void * const items[], size_t count) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t room = spsc_queue__room(queue, tail, count);
+    size_t n = (count < room) ? count : room;
+    size_t start = tail & queue->mask;
+    size_t first = queue->mask + 1 - start;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(&queue->slots[start], items, first * sizeof(void *));
+    memcpy(&queue->slots[0], items + first, (n - first) * sizeof(void *));
+    atomic_store_explicit(&queue->tail, tail + n, memory_order_release);
+    if (n > 0) {
+        INH_QUEUE__NOTIFY(queue, not_empty);
+    }
+    return n;
+}
+
+/*
+ * Take up to count of the oldest items from the queue at once.
+ * Returns the number of items taken.
+ */
+size_t spsc_queue_pop_batch (INH_spsc_queue * queue, void * items[], size_t count) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t ready = spsc_queue__ready(queue, head, count);
+    size_t n = (count < ready) ? count : ready;
+    size_t start = head & queue->mask;
+    size_t first = queue->mask + 1 - start;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(items, &queue->slots[start], first * sizeof(void *));
+    memcpy(items + first, &queue->slots[0], (n - first) * sizeof(void *));
+    atomic_store_explicit(&queue->head, head + n, memory_order_release);
+    if (n > 0) {
+        INH_QUEUE__NOTIFY(queue, not_full);
+    }
+    return n;
+}
+
+/*
+ * Like spsc_queue_push, but waits while the queue is full, spinning and then
+ * yielding (or sleeping, with INH_QUEUE_BLOCKING).
+ */
+void spsc_queue_push_wait (INH_spsc_queue * queue, void * item) {
+    unsigned spins = 0;
+    while (!spsc_queue_push(queue, item)) {
+        INH_QUEUE__WAIT(queue, not_full, spins, spsc_queue_push(queue, item))
+        queue__backoff(&spins);
+    }
+}
+
+/*
+ * Like spsc_queue_pop, but waits while the queue is empty, spinning and then
+ * yielding (or sleeping, with INH_QUEUE_BLOCKING).
+ * Returns the item.
+ */
+void * spsc_queue_pop_wait (INH_spsc_queue * queue) {
+    unsigned spins = 0;
+    void * item;
+    while (!spsc_queue_pop(queue, &item)) {
+        INH_QUEUE__WAIT(queue, not_empty, spins, spsc_queue_pop(queue, &item))
+        queue__backoff(&spins);
+    }
+    return item;
+}
+
+/*
+ * Create a queue for any number of producers and consumers that holds at
+ * least capacity items. The capacity is rounded up to a power of two.
+ * Returns NULL if the capacity is too big or the queue could not be
+ * allocated.
+ */
+INH_mpmc_queue * mpmc_queue_create (size_t capacity) {
+    capacity = queue__capacity(capacity);
+    if (capacity == 0 || capacity > (SIZE_MAX - sizeof(INH_mpmc_queue)) / sizeof(INH_mpmc_cell)) {
+        return NULL;
+    }
+    INH_mpmc_queue * queue = queue__alloc(sizeof(*queue) + capacity * sizeof(INH_mpmc_cell));
+    if (queue == NULL) {
+        return queue;
+    }
+    if (!INH_QUEUE__EVENTS_INIT(queue)) {
+        free(queue);
+        return NULL;
+    }
+    size_t i;
+    for (i = 0; i < capacity; i++) {
+        // Cell i is first ready for the push at position i
+        atomic_init(&queue->cells[i].sequence, i);
+    }
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+    queue->mask = capacity - 1;
+    return queue;
+}
+
+void mpmc_queue_destroy (INH_mpmc_queue * queue) {
+    INH_QUEUE__EVENTS_DESTROY(queue);
+    free(queue);
+}
+
+size_t mpmc_queue_capacity (const INH_mpmc_queue * queue) {
+    return queue->mask + 1;
+}
+
+/*
+ * Claim up to count positions in a row starting from *pos, where each cell
+ * must have the sequence number position + offset.
+ * Returns the number of positions claimed, and sets *pos to the first one.
+ */
+static size_t mpmc_queue__claim (INH_mpmc_queue * queue, atomic_size_t * position, size_t offset, size_t count, size_t * pos) {
+    size_t start = atomic_load_explicit(position, memory_order_relaxed);
+    for (;;) {
+        size_t n = 0;
+        while (n < count) {
+            INH_mpmc_cell * cell = &queue->cells[(start + n) & queue->mask];
+            size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)(sequence - (start + n + offset));
+            if (diff != 0) {
+                if (n == 0 && diff > 0) {
+                    // Another thread took this position first
+                    n = (size_t)-1;
+                }
+                break;
+            }
+            n++;
+        }
+        if (n == (size_t)-1) {
+            start = atomic_load_explicit(position, memory_order_relaxed);
+            continue;
+        }
+        if (n == 0) {
+            // Full or empty
+            return 0;
+        }
+        if (atomic_compare_exchange_weak_explicit(position, &start, start + n,
+                memory_order_relaxed, memory_order_relaxed)) {
+            *pos = start;
+            return n;
+        }
+    }
+}
+
+/*
+ * Add an item to the queue.
+ * Returns false if the queue is full.
+ */
+bool mpmc_queue_push (INH_mpmc_queue * queue, void * item) {
+    return mpmc_queue_push_batch(queue, &item, 1) == 1;
+}
+
+/*
+ * Take the oldest item from the queue.
+ * Returns false if the queue is empty.
+ */
+bool mpmc_queue_pop (INH_mpmc_queue * queue, void ** item) {
+    return mpmc_queue_pop_batch(queue, item, 1) == 1;
+}
+
+/*
+ * Add up to count items to the queue, claiming their cells together.
+ * The items stay in order, but items from other producers may come between
+ * batches.
+ * Returns the number of items added.
+ */
+size_t mpmc_queue_push_batch (INH_mpmc_queue * queue, void * const items[], size_t count) {
+    size_t pos;
+    size_t n = mpmc_queue__claim(queue, &queue->enqueue_pos, 0, count, &pos);
+    size_t i;
+    for (i = 0; i < n; i++) {
+        INH_mpmc_cell * cell = &queue->cells[(pos + i) & queue->mask];
+        cell->data = items[i];
+        // Ready for the pop at this position
+        atomic_store_explicit(&cell->sequence, pos + i + 1, memory_order_release);
+    }
+    if (n > 0) {
+        INH_QUEUE__NOTIFY(queue, not_empty);
+    }
+    return n;
+}
+
+/*
+ * Take up to count of the oldest items from the queue, claiming their cells
+ * together.
+ * Returns the number of items taken.
+ */
+size_t mpmc_queue_pop_batch (INH_mpmc_queue * queue, void * items[], size_t count) {
+    size_t pos;
+    size_t n = mpmc_queue__claim(queue, &queue->dequeue_pos, 1, count, &pos);
+    size_t i;
+    for (i = 0; i < n; i++) {
+        INH_mpmc_cell * cell = &queue->cells[(pos + i) & queue->mask];
+        items[i] = cell->data;
+        // Ready for the push one lap later
+        atomic_store_explicit(&cell->sequence, pos + i + queue->mask + 1, memory_order_release);
+    }
+    if (n > 0) {
+        INH_QUEUE__NOTIFY(queue, not_full);
+    }
+    return n;
+}
+
+/*
+ * Like mpmc_queue_push, but waits while the queue is full, spinning and then
+ * yielding (or sleeping, with INH_QUEUE_BLOCKING).
+ */
+void mpmc_queue_push_wait (INH_mpmc_queue * queue, void * item) {
+    unsigned spins = 0;
+    while (!mpmc_queue_push(queue, item)) {
+        INH_QUEUE__WAIT(queue, not_full, spins, mpmc_queue_push(queue, item))
+        queue__backoff(&spins);
+    }
+}
+
+/*
+ * Like mpmc_queue_pop, but waits while the queue is empty, spinning and then
+ * yielding (or sleeping, with INH_QUEUE_BLOCKING).
+ * Returns the item.
+ */
+void * mpmc_queue_pop_wait (INH_mpmc_queue * queue) {
+    unsigned spins = 0;
+    void * item;
+    while (!mpmc_queue_pop(queue, &item)) {
+        INH_QUEUE__WAIT(queue, not_empty, spins, mpmc_queue_pop(queue, &item))
+        queue__backoff(&spins);
+    }
+    return item;
+}
+
+// --- End of implementation --- //
+
+#endif // INH_QUEUE_IMPLEMENTATION
+
+/***
+
+= inh_queue.h 0.1.0 =
+
+This is a single file header for fixed-size queues of pointers that pass
+work between threads, in the C Programming language. It needs C11 atomics.
+
+INH_spsc_queue is for exactly one producer thread and one consumer thread,
+and INH_mpmc_queue is for any number of each. Both hold a fixed number of
+items, so pushing onto a full queue or popping from an empty one fails
+instead of allocating or blocking. The _wait functions keep trying instead,
+spinning for a moment and then yielding the processor, which keeps a
+processor busy for as long as they wait.
+
+To have the _wait functions sleep after spinning, until another thread
+changes the queue, define INH_QUEUE_BLOCKING before including this file (in
+every file that includes it) and link with pthreads. Pushing and popping
+then also check for waiting threads, and only lock to wake them if there
+are any. INH_QUEUE_SPINS sets how many times they try before yielding or
+sleeping.
+
+== Usage ==
+
+Write the following to use the file as a normal header:
+
+ #include "inh_queue.h"
+
+and then in one and only one file, write the following after including any
+files that depend on this header:
+
+ #define INH_QUEUE_IMPLEMENTATION
+ #include "inh_queue.h"
+
+If you want the implementation to be private to the file that defines
+INH_QUEUE_IMPLEMENTATION, you can write the following instead:
+
+ #define INH_QUEUE_STATIC
+ #define INH_QUEUE_IMPLEMENTATION
+ #include "inh_queue.h"
+
+== Changelog ==
+
+All notable changes to this project will be documented in this section.
+
+The format is based on [Keep a Changelog](https://keepachangelog.com/en/1.0.0/),
+and this project adheres to [Semantic Versioning](https://semver.org/spec/v2.0.0.html).
+
+This project uses semantic versioning [https://semver.org].
+
+=== [0.1.0] - 2026-10-19 ===
+==== Added ====
+* INH_spsc_queue and INH_mpmc_queue, with batch and waiting versions of
+  push and pop
+* INH_QUEUE_BLOCKING, for _wait functions that sleep instead of spinning
+
+== License ==
+
+Copyright (c) 2021 Izak Nathanael Halseide
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+***/
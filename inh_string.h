@@ -17,6 +17,21 @@
 #include <stdio.h>
 #endif
 
+#ifndef INH_STRING_NO_STDINT
+#include <stdint.h>
+#endif
+
+#ifdef INH_STRING_REFCOUNT
+#include <stdatomic.h>
+#endif
+
+// File descriptor functions are available on POSIX systems, unless
+// INH_STRING_NO_POSIX is defined
+#if !defined(INH_STRING_NO_POSIX) && (defined(__unix__) || defined(__APPLE__))
+#define INH_STRING__POSIX
+#include <sys/types.h>
+#endif
+
 #ifndef INH_STRING_DEF
 #ifdef INH_STRING_STATIC
 #define INH_STRING_DEF static
@@ -28,12 +43,114 @@
 /*
  * The main length-encoded string structure.
  * The character data is stored in a variable-size array.
+ * With INH_STRING_REFCOUNT, it also counts how many owners share it.
  */
 typedef struct INH_string {
+#ifdef INH_STRING_REFCOUNT
+    atomic_size_t refs;
+#endif
     size_t len;
     char buffer[];
 } INH_string;
 
+/*
+ * A non-owning view of a run of characters, such as part of a String.
+ * The viewed characters must outlive the view.
+ */
+typedef struct INH_view {
+    const char * data;
+    size_t len;
+} INH_view;
+
+/*
+ * A String literal with its length worked out at compile time, and no heap
+ * allocation, like:
+ *
+ *  static const INH_string * const keywords[] = { STR_LITERAL("if"), STR_LITERAL("else") };
+ *
+ * At file scope it lasts for the whole program, and inside a function until
+ * the end of the enclosing block. It must not be modified, resized or freed.
+ * With INH_STRING_REFCOUNT it counts as shared, so the copy-on-write
+ * functions copy it.
+ */
+#ifdef INH_STRING_REFCOUNT
+#define STR__LITERAL_REFS_FIELD atomic_size_t refs;
+#define STR__LITERAL_REFS SIZE_MAX / 2,
+#else
+#define STR__LITERAL_REFS_FIELD
+#define STR__LITERAL_REFS
+#endif
+
+#define STR_LITERAL(literal) \
+    ((const INH_string *)(void *)&(struct { STR__LITERAL_REFS_FIELD size_t len; char buffer[sizeof(literal)]; }) \
+     { STR__LITERAL_REFS sizeof(literal) - 1, literal })
+
+/*
+ * A perfect hash table over a fixed set of keys: every key has its own slot,
+ * so finding a key takes one hash and one comparison.
+ * Build one with str_table_build, or write one out as C code with
+ * str_table_write_c to compile it into a program.
+ */
+typedef struct INH_string_table {
+    const INH_string * const * keys; // By slot, or NULL for an empty slot
+    const int * indices; // By slot, the index of the key in the original list
+    const uint32_t * seeds; // By bucket, the seed that places its keys
+    size_t bucket_count;
+    size_t slot_count;
+} INH_string_table;
+
+/*
+ * A list of pieces of text that make up one string without being copied
+ * together, for writing out with writev or flattening once.
+ * The list does not own the text, which must outlive it.
+ */
+typedef struct INH_string_list {
+    INH_view * parts;
+    size_t count;
+    size_t capacity;
+    size_t total_len; // Valid only when total_known
+    bool total_known;
+} INH_string_list;
+
+/*
+ * A buffered reader that splits a FILE * or file descriptor into records
+ * ending with a delimiter, as views into its own buffer.
+ */
+typedef struct INH_string_reader {
+    FILE * file; // Source, or NULL when reading from fd
+    int fd;
+    char delim;
+    char * buffer;
+    size_t capacity;
+    size_t block_size;
+    size_t start; // Start of the unread data in buffer
+    size_t end; // End of the unread data in buffer
+    size_t scanned; // Bytes after start that have no delimiter
+    bool eof;
+    bool error;
+#ifdef INH_STRING_THREADS
+    struct str__read_ahead * ahead; // NULL unless reading ahead
+#endif
+} INH_string_reader;
+
+/*
+ * A compact String for large numbers of short strings.
+ * Its length is stored in 1, 2, 4 or 8 bytes depending on its size, and it
+ * can have a null character after its text so that it is also a C string.
+ * The structure is only used through pointers.
+ */
+typedef struct INH_packed_string INH_packed_string;
+
+/*
+ * Builds a String by appending to it in place.
+ * The String is allocated with spare room, and string->len is the whole room,
+ * while len is how much of it is used.
+ */
+typedef struct INH_string_builder {
+    INH_string * string;
+    size_t len;
+} INH_string_builder;
+
 INH_STRING_DEF INH_string * str_alloc(size_t len); 
 
 INH_STRING_DEF INH_string * str_realloc (INH_string * str, size_t new_len); 
@@ -46,6 +163,14 @@ INH_STRING_DEF INH_string * str_new_sub (const INH_string * source, size_t start
 
 INH_STRING_DEF INH_string * str_dup (const INH_string * string); 
 
+INH_STRING_DEF INH_string * str_retain (INH_string * string); 
+
+INH_STRING_DEF void str_release (INH_string * string); 
+
+INH_STRING_DEF bool str_is_shared (const INH_string * string); 
+
+INH_STRING_DEF INH_string * str_unshare (INH_string * string); 
+
 INH_STRING_DEF size_t str_copy_from (INH_string * dest, const INH_string * source, size_t start); 
 
 INH_STRING_DEF size_t str_copy (INH_string * dest, const INH_string * source); 
@@ -76,6 +201,8 @@ INH_STRING_DEF bool str_equal (const INH_string * str1, const INH_string * str2)
 
 INH_STRING_DEF bool str_notequal (const INH_string * str1, const INH_string * str2);
 
+INH_STRING_DEF int str_compare (const INH_string * str1, const INH_string * str2); 
+
 INH_STRING_DEF int str_fprint (const INH_string * string, FILE * stream); 
 
 INH_STRING_DEF int str_print (const INH_string * string); 
@@ -84,6 +211,150 @@ INH_STRING_DEF int str_fput (const INH_string * string, FILE * stream);
 
 INH_STRING_DEF int str_put (const INH_string * string); 
 
+INH_STRING_DEF INH_string * str_to_lower (INH_string * string); 
+
+INH_STRING_DEF INH_string * str_to_lower_new (const INH_string * string); 
+
+INH_STRING_DEF INH_string * str_to_upper (INH_string * string); 
+
+INH_STRING_DEF INH_string * str_to_upper_new (const INH_string * string); 
+
+INH_STRING_DEF INH_string * str_trim (INH_string * string); 
+
+INH_STRING_DEF INH_string * str_trim_new (const INH_string * string); 
+
+INH_STRING_DEF INH_string * str_replace_char (INH_string * string, char from, char to); 
+
+INH_STRING_DEF INH_string * str_replace_char_new (const INH_string * string, char from, char to); 
+
+INH_STRING_DEF INH_string * str_translate (INH_string * string, const unsigned char table[256]); 
+
+INH_STRING_DEF INH_string * str_translate_new (const INH_string * string, const unsigned char table[256]); 
+
+INH_STRING_DEF INH_string * str_filter (INH_string * string, const bool keep[256]); 
+
+INH_STRING_DEF INH_string * str_filter_new (const INH_string * string, const bool keep[256]); 
+
+INH_STRING_DEF INH_view str_view (const INH_string * string); 
+
+INH_STRING_DEF INH_view str_view_sub (const INH_string * string, size_t start, size_t end); 
+
+INH_STRING_DEF INH_view str_view_cstr (const char * stream); 
+
+INH_STRING_DEF INH_string * str_append_u64 (INH_string * string, uint64_t value); 
+
+INH_STRING_DEF INH_string * str_append_int (INH_string * string, int64_t value); 
+
+INH_STRING_DEF INH_string * str_append_double (INH_string * string, double value); 
+
+INH_STRING_DEF size_t str_parse_u64 (INH_view view, uint64_t * value); 
+
+INH_STRING_DEF size_t str_parse_int (INH_view view, int64_t * value); 
+
+INH_STRING_DEF size_t str_parse_double (INH_view view, double * value); 
+
+INH_STRING_DEF void str_list_init (INH_string_list * list); 
+
+INH_STRING_DEF void str_list_free (INH_string_list * list); 
+
+INH_STRING_DEF bool str_list_add_view (INH_string_list * list, INH_view view); 
+
+INH_STRING_DEF bool str_list_add (INH_string_list * list, const INH_string * string); 
+
+INH_STRING_DEF size_t str_list_len (INH_string_list * list); 
+
+INH_STRING_DEF size_t str_list_write_stream (const INH_string_list * list, char * stream); 
+
+INH_STRING_DEF INH_string * str_list_flatten (INH_string_list * list); 
+
+INH_STRING_DEF int str_list_fwrite (const INH_string_list * list, FILE * stream); 
+
+#ifdef INH_STRING__POSIX
+INH_STRING_DEF ssize_t str_list_writev (const INH_string_list * list, int fd); 
+#endif
+
+INH_STRING_DEF bool str_reader_init (INH_string_reader * reader, FILE * file, char delim, size_t block_size); 
+
+#ifdef INH_STRING__POSIX
+INH_STRING_DEF bool str_reader_init_fd (INH_string_reader * reader, int fd, char delim, size_t block_size); 
+#endif
+
+#ifdef INH_STRING_THREADS
+INH_STRING_DEF bool str_reader_start_read_ahead (INH_string_reader * reader); 
+#endif
+
+INH_STRING_DEF bool str_reader_next (INH_string_reader * reader, INH_view * record); 
+
+INH_STRING_DEF bool str_reader_error (const INH_string_reader * reader); 
+
+INH_STRING_DEF void str_reader_free (INH_string_reader * reader); 
+
+INH_STRING_DEF void str_sort (INH_string * strings[], size_t len); 
+
+#ifdef INH_STRING_THREADS
+INH_STRING_DEF void str_sort_parallel (INH_string * strings[], size_t len, int threads); 
+#endif
+
+INH_STRING_DEF bool str_builder_init (INH_string_builder * builder, size_t capacity); 
+
+INH_STRING_DEF bool str_builder_reserve (INH_string_builder * builder, size_t extra); 
+
+INH_STRING_DEF bool str_builder_append_char (INH_string_builder * builder, char ch); 
+
+INH_STRING_DEF bool str_builder_append_view (INH_string_builder * builder, INH_view view); 
+
+INH_STRING_DEF bool str_builder_append (INH_string_builder * builder, const INH_string * string); 
+
+INH_STRING_DEF bool str_builder_printf (INH_string_builder * builder, const char * format, ...); 
+
+INH_STRING_DEF bool str_builder_append_json (INH_string_builder * builder, INH_view view); 
+
+INH_STRING_DEF bool str_builder_append_csv (INH_string_builder * builder, INH_view view, char sep); 
+
+INH_STRING_DEF INH_string * str_builder_finish (INH_string_builder * builder); 
+
+INH_STRING_DEF void str_builder_free (INH_string_builder * builder); 
+
+INH_STRING_DEF INH_packed_string * str_packed_new_len (const char * stream, size_t len, bool terminate); 
+
+INH_STRING_DEF INH_packed_string * str_packed_new (const char * stream); 
+
+INH_STRING_DEF INH_packed_string * str_packed_from (const INH_string * string, bool terminate); 
+
+INH_STRING_DEF INH_string * str_packed_to_string (const INH_packed_string * packed); 
+
+INH_STRING_DEF size_t str_packed_len (const INH_packed_string * packed); 
+
+INH_STRING_DEF char * str_packed_data (INH_packed_string * packed); 
+
+INH_STRING_DEF INH_view str_packed_view (const INH_packed_string * packed); 
+
+INH_STRING_DEF const char * str_packed_cstr (const INH_packed_string * packed); 
+
+INH_STRING_DEF size_t str_packed_alloc_size (const INH_packed_string * packed); 
+
+INH_STRING_DEF INH_packed_string * str_packed_dup (const INH_packed_string * packed); 
+
+INH_STRING_DEF INH_packed_string * str_packed_append (INH_packed_string * packed, char ch); 
+
+INH_STRING_DEF INH_packed_string * str_packed_cat (INH_packed_string * packed, INH_view view); 
+
+INH_STRING_DEF bool str_packed_equal (const INH_packed_string * packed1, const INH_packed_string * packed2); 
+
+INH_STRING_DEF int str_packed_compare (const INH_packed_string * packed1, const INH_packed_string * packed2); 
+
+INH_STRING_DEF void str_packed_free (INH_packed_string * packed); 
+
+INH_STRING_DEF uint64_t str_hash (INH_view view); 
+
+INH_STRING_DEF bool str_table_build (INH_string_table * table, const INH_string * const keys[], size_t count); 
+
+INH_STRING_DEF int str_table_find (const INH_string_table * table, INH_view key); 
+
+INH_STRING_DEF int str_table_write_c (const INH_string_table * table, FILE * stream, const char * name); 
+
+INH_STRING_DEF void str_table_free (INH_string_table * table); 
+
 // --- End header code --- //
 
 #endif // INH_INCLUDE_INH_STRING_H
@@ -91,8 +362,34 @@ INH_STRING_DEF int str_put (const INH_string * string);
 #ifdef INH_STRING_IMPLEMENTATION
 
 #include <assert.h>
+#include <math.h>
+#include <stdarg.h>
 #include <string.h>
 
+#ifdef INH_STRING__POSIX
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef INH_STRING_THREADS
+#include <pthread.h>
+#ifdef INH_STRING__POSIX
+// POSIX, but not declared by some C libraries in strict C modes
+int fileno (FILE * stream);
+#endif
+#endif
+
+// SSE2 kernels are used where available, unless INH_STRING_NO_SIMD is defined
+#if !defined(INH_STRING_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define INH_STRING__SSE2
+#include <emmintrin.h>
+#endif
+
+static size_t str__mismatch (const char * p1, const char * p2, size_t len);
+
 /*
  * String constructor
  */
@@ -100,15 +397,37 @@ INH_string * str_alloc (size_t len) {
     INH_string * new;
     new = malloc(sizeof(*new) + len);
     if (new != NULL) {
+#ifdef INH_STRING_REFCOUNT
+        atomic_init(&new->refs, 1);
+#endif
         new->len = len;
     }
     return new;
 }
 
+/*
+ * Resize a String.
+ * A shared String is left to its other owners, and a resized copy is
+ * returned instead.
+ */
 INH_string * str_realloc (INH_string * str, size_t new_len) {
     INH_string * result;
+#ifdef INH_STRING_REFCOUNT
+    if (str_is_shared(str)) {
+        result = str_alloc(new_len);
+        if (result == NULL) {
+            // Keep the caller's reference, like realloc keeps the old block
+            return NULL;
+        }
+        memcpy(result->buffer, str->buffer, (str->len < new_len) ? str->len : new_len);
+        str_release(str);
+        return result;
+    }
+#endif
     result = realloc(str, sizeof(*result) + new_len);
-    result->len = new_len;
+    if (result != NULL) {
+        result->len = new_len;
+    }
     return result;
 }
 
@@ -117,10 +436,10 @@ INH_string * str_realloc (INH_string * str, size_t new_len) {
  */
 INH_string * str_new_len (const char * stream, size_t len) {
     INH_string * new = str_alloc(len);
-    int i;
-    for (i = 0; i < len; i++) {
-        new->buffer[i] = stream[i];
+    if (new == NULL) {
+        return new;
     }
+    memcpy(new->buffer, stream, len);
     return new;
 }
 
@@ -183,13 +502,15 @@ int str_put (const INH_string * string) {
 
 /*
  * Returns length copied, which is the minimum length of the source and destination
+ * Nothing is copied into a shared dest, and then 0 is returned.
  */
 size_t str_copy_from (INH_string * dest, const INH_string * source, size_t start) {
+    if (str_is_shared(dest)) {
+        // Other owners would see the change
+        return 0;
+    }
     size_t len = (dest->len < source->len) ? dest->len : source->len;
-    size_t i;
-    for (i = start; i < start + len; i++) {
-        dest->buffer[i - start] = source->buffer[i];
-    } 
+    memcpy(dest->buffer, source->buffer + start, len);
     return len;
 }
 
@@ -207,6 +528,62 @@ INH_string * str_dup (const INH_string * string) {
     return new;
 }
 
+/*
+ * Add an owner to a String, instead of duplicating it.
+ * With INH_STRING_REFCOUNT, this counts the new owner and returns the same
+ * String. Otherwise, it is the same as str_dup.
+ * Each owner gives up the String with str_release.
+ */
+INH_string * str_retain (INH_string * string) {
+#ifdef INH_STRING_REFCOUNT
+    atomic_fetch_add_explicit(&string->refs, 1, memory_order_relaxed);
+    return string;
+#else
+    return str_dup(string);
+#endif
+}
+
+/*
+ * Remove an owner from a String, and free it when it was the last one.
+ */
+void str_release (INH_string * string) {
+#ifdef INH_STRING_REFCOUNT
+    if (atomic_fetch_sub_explicit(&string->refs, 1, memory_order_release) != 1) {
+        return;
+    }
+    // Make the other owners' last accesses happen before the free
+    atomic_thread_fence(memory_order_acquire);
+#endif
+    free(string);
+}
+
+/*
+ * Returns if a String has more than one owner, and so must not be modified
+ * in place.
+ */
+bool str_is_shared (const INH_string * string) {
+#ifdef INH_STRING_REFCOUNT
+    return atomic_load_explicit(&((INH_string *)string)->refs, memory_order_acquire) > 1;
+#else
+    (void)string;
+    return false;
+#endif
+}
+
+/*
+ * Get a String that can be modified in place.
+ * If the String is shared, this releases it and returns a copy.
+ * Returns the string pointer.
+ */
+INH_string * str_unshare (INH_string * string) {
+    if (!str_is_shared(string)) {
+        return string;
+    }
+    INH_string * new = str_dup(string);
+    str_release(string);
+    return new;
+}
+
 /*
  * Create a new String that represents the substring start...end in the
  * source String
@@ -216,10 +593,10 @@ INH_string * str_dup (const INH_string * string) {
 INH_string * str_new_sub (const INH_string * source, size_t start, size_t end) {
     assert(((int)end - (int)start) >= 0);
     INH_string * new = str_alloc(end - start);
-    int i;
-    for (i = start; i < end; i++) {
-        new->buffer[i - start] = source->buffer[i];
+    if (new == NULL) {
+        return new;
     }
+    memcpy(new->buffer, source->buffer + start, end - start);
     return new;
 }
 
@@ -253,23 +630,20 @@ INH_string * str_append_new (const INH_string * string, char ch) {
  * Returns the number of characters written
  */
 size_t str_write_stream (const INH_string * string, char * stream) {
-    size_t i;
-    for (i = 0; i < string->len; i++) {
-        stream[i] = string->buffer[i];
-    }
-    return i;
+    memcpy(stream, string->buffer, string->len);
+    return string->len;
 }
 
 /*
  * Write a String to a char stream, but use null-termination
  */
 size_t str_write_stream_term (const INH_string * string, char * stream) {
-    size_t i;
-    for (i = 0; (i < string->len) && string->buffer[i] != '\0'; i++) { 
-        stream[i] = string->buffer[i];
-    }
-    stream[i] = '\0';
-    return i;
+    // Stop at the first null character, if there is one
+    const char * null = memchr(string->buffer, '\0', string->len);
+    size_t len = null ? (size_t)(null - string->buffer) : string->len;
+    memcpy(stream, string->buffer, len);
+    stream[len] = '\0';
+    return len;
 }
 
 /*
@@ -294,10 +668,7 @@ char * str_convert (const INH_string * str) {
 INH_string * str_new_cat (const INH_string * first, const INH_string * next) {
     INH_string * new = str_alloc(first->len + next->len);
     size_t first_end = str_copy(new, first);
-    size_t i;
-    for (i = first_end; i < new->len; i++) {
-        new->buffer[i] = next->buffer[i - first_end];
-    }
+    memcpy(new->buffer + first_end, next->buffer, next->len);
     return new;
 }
 
@@ -308,24 +679,21 @@ INH_string * str_new_cat (const INH_string * first, const INH_string * next) {
 INH_string * str_cat (INH_string ** dest, const INH_string * source) {
     size_t orig_len = (*dest)->len;
     *dest = str_realloc(*dest, orig_len + source->len);
-
-    int i;
-    for (i = 0; i < source->len; i++) {
-        (*dest)->buffer[orig_len + i] = source->buffer[i];
-    }
-
+    memcpy((*dest)->buffer + orig_len, source->buffer, source->len);
     return *dest;
 }
 
 /*
  * Returns (index + source->len)
+ * Nothing is copied into a shared dest, and then index is returned.
  */
 size_t str_cat_at (INH_string * dest, const INH_string * source, size_t index) { 
-    size_t i;
-    for (i = 0; i < source->len; i++) {
-        dest->buffer[index + i] = source->buffer[i];
-    } 
-    return index + i;
+    if (str_is_shared(dest)) {
+        // Other owners would see the change
+        return index;
+    }
+    memcpy(dest->buffer + index, source->buffer, source->len);
+    return index + source->len;
 }
 
 /*
@@ -377,13 +745,11 @@ bool str_equal_sub (const INH_string * str1, const INH_string * str2, size_t sta
     if (sub_len > str1->len || sub_len > str2->len) {
         return false;
     }
-    int i;
-    for (i = 0; i < sub_len; i++) {
-        if (str1->buffer[i] != str2->buffer[i]) {
-            return false;
-        }
+    if (sub_len == 0) {
+        // Empty strings have no characters to read
+        return true;
     }
-    return true;
+    return str__mismatch(str1->buffer, str2->buffer, sub_len) == sub_len;
 }
 
 /*
@@ -395,13 +761,7 @@ bool str_notequal_sub (const INH_string * str1, const INH_string * str2, size_t
     if (sub_len > str1->len || sub_len > str2->len) {
         return true;
     }
-    int i;
-    for (i = 0; i < sub_len; i++) {
-        if (str1->buffer[i] != str2->buffer[i]) {
-            return true;
-        }
-    }
-    return false;
+    return str__mismatch(str1->buffer, str2->buffer, sub_len) != sub_len;
 }
 
 /*
@@ -430,27 +790,2695 @@ bool str_notequal (const INH_string * str1, const INH_string * str2) {
     return str_notequal_sub(str1, str2, 0, str1->len);
 }
 
-// --- End of implementation --- //
+/*
+ * Returns the index of the first byte that differs between two runs of len
+ * bytes, or len if they are the same.
+ */
+static size_t str__mismatch (const char * p1, const char * p2, size_t len) {
+    size_t i = 0;
+#ifdef INH_STRING__SSE2
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(p1 + i));
+        __m128i y = _mm_loadu_si128((const __m128i *)(p2 + i));
+        unsigned differ = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xffff;
+        if (differ) {
+#if defined(__GNUC__) || defined(__clang__)
+            return i + __builtin_ctz(differ);
+#else
+            while (!(differ & 1)) {
+                differ >>= 1;
+                i++;
+            }
+            return i;
+#endif
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        if (p1[i] != p2[i]) {
+            break;
+        }
+    }
+    return i;
+}
 
-#endif // INH_STRING_IMPLEMENTATION
+/*
+ * Compare two strings from the given offset onwards, which must be at most
+ * the length of each.
+ */
+static int str__compare_from (const INH_string * str1, const INH_string * str2, size_t offset) {
+    size_t len = (str1->len < str2->len) ? str1->len : str2->len;
+    size_t i = offset + str__mismatch(str1->buffer + offset, str2->buffer + offset, len - offset);
+    if (i < len) {
+        return ((unsigned char)str1->buffer[i] < (unsigned char)str2->buffer[i]) ? -1 : 1;
+    }
+    if (str1->len == str2->len) {
+        return 0;
+    }
+    return (str1->len < str2->len) ? -1 : 1;
+}
 
-/***
+/*
+ * Compare two strings lexicographically by unsigned byte value, like memcmp.
+ * A string that is a prefix of the other comes first.
+ * Returns a negative number, 0 or a positive number if str1 is less than,
+ * equal to or greater than str2.
+ */
+int str_compare (const INH_string * str1, const INH_string * str2) {
+    if (str1 == str2) {
+        return 0;
+    }
+    return str__compare_from(str1, str2, 0);
+}
 
-= inh_string.h 0.1.0 =
+/*
+ * Kernel for case conversion: copies len bytes from src to dest, flipping
+ * the case bit of any byte in the range lo...(lo + 25).
+ * src and dest may be the same buffer.
+ */
+static void str__flip_case (char * dest, const char * src, size_t len, char lo) {
+    size_t i = 0;
+#ifdef INH_STRING__SSE2
+    // Bias the bytes so that the range check becomes one signed compare
+    const __m128i bias = _mm_set1_epi8((char)(0x80 - lo));
+    const __m128i limit = _mm_set1_epi8((char)(0x80 + 26));
+    const __m128i bit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i in_range = _mm_cmplt_epi8(_mm_add_epi8(x, bias), limit);
+        x = _mm_xor_si128(x, _mm_and_si128(in_range, bit));
+        _mm_storeu_si128((__m128i *)(dest + i), x);
+    }
+#endif
+    // 8 bytes at a time in a uint64_t. Each byte's low 7 bits plus a bias
+    // can't carry into the next byte, and sets its high bit past a bound.
+    const uint64_t ones = 0x0101010101010101u;
+    const uint64_t high = ones * 0x80;
+    const uint64_t from_lo = ones * (unsigned char)(0x80 - lo);
+    const uint64_t past_hi = ones * (unsigned char)(0x80 - lo - 26);
+    for (; i + 8 <= len; i += 8) {
+        uint64_t x;
+        memcpy(&x, src + i, 8);
+        uint64_t low7 = x & ~high;
+        uint64_t in_range = (low7 + from_lo) & ~(low7 + past_hi) & ~x & high;
+        x ^= in_range >> 2;
+        memcpy(dest + i, &x, 8);
+    }
+    for (; i < len; i++) {
+        unsigned char c = src[i];
+        if ((unsigned char)(c - lo) < 26) {
+            c ^= 0x20;
+        }
+        dest[i] = c;
+    }
+}
 
-This is a single file header for the use of length-encoded Strings in the C
-Programming language.
+/*
+ * Kernel for character replacement: copies len bytes from src to dest,
+ * replacing every from byte with to.
+ * src and dest may be the same buffer.
+ */
+static void str__replace_char (char * dest, const char * src, size_t len, char from, char to) {
+    size_t i = 0;
+#ifdef INH_STRING__SSE2
+    const __m128i from_v = _mm_set1_epi8(from);
+    const __m128i diff_v = _mm_set1_epi8((char)(from ^ to));
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i match = _mm_cmpeq_epi8(x, from_v);
+        x = _mm_xor_si128(x, _mm_and_si128(match, diff_v));
+        _mm_storeu_si128((__m128i *)(dest + i), x);
+    }
+#endif
+    for (; i < len; i++) {
+        char c = src[i];
+        dest[i] = (c == from) ? to : c;
+    }
+}
 
-== Usage ==
+/*
+ * Kernel for byte filtering: copies the bytes of src that are marked in keep
+ * to dest.
+ * src and dest may be the same buffer.
+ * Returns the number of bytes kept.
+ */
+static size_t str__filter (char * dest, const char * src, size_t len, const bool keep[256]) {
+    size_t i, j = 0;
+    for (i = 0; i < len; i++) {
+        unsigned char c = src[i];
+        // Branchless: always write, but only advance past kept bytes
+        dest[j] = c;
+        j += keep[c] ? 1 : 0;
+    }
+    return j;
+}
 
-Write the following to use the file as a normal header:
+static bool str__is_space (char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
 
- #include "inh_string.h"
+/*
+ * Find the bounds of a string with leading and trailing whitespace removed.
+ */
+static void str__trim_bounds (const INH_string * string, size_t * start, size_t * end) {
+    // Runs of whitespace at the ends are short, so this is a plain loop
+    size_t s = 0, e = string->len;
+    while (s < e && str__is_space(string->buffer[s])) {
+        s++;
+    }
+    while (e > s && str__is_space(string->buffer[e - 1])) {
+        e--;
+    }
+    *start = s;
+    *end = e;
+}
 
-and then in one and only one file, write the following after including any 
-files that depend on this header:
+/*
+ * Convert ASCII letters in a String to lowercase, in place.
+ * Returns the string pointer.
+ */
+INH_string * str_to_lower (INH_string * string) {
+    if (str_is_shared(string)) {
+        // Copy and transform in one pass
+        INH_string * new = str_to_lower_new(string);
+        str_release(string);
+        return new;
+    }
+    str__flip_case(string->buffer, string->buffer, string->len, 'A');
+    return string;
+}
 
- #define INH_STRING_IMPLEMENTATION
+/*
+ * Allocate a lowercase copy of a String.
+ */
+INH_string * str_to_lower_new (const INH_string * string) {
+    INH_string * new = str_alloc(string->len);
+    if (new == NULL) {
+        return new;
+    }
+    str__flip_case(new->buffer, string->buffer, string->len, 'A');
+    return new;
+}
+
+/*
+ * Convert ASCII letters in a String to uppercase, in place.
+ * Returns the string pointer.
+ */
+INH_string * str_to_upper (INH_string * string) {
+    if (str_is_shared(string)) {
+        // Copy and transform in one pass
+        INH_string * new = str_to_upper_new(string);
+        str_release(string);
+        return new;
+    }
+    str__flip_case(string->buffer, string->buffer, string->len, 'a');
+    return string;
+}
+
+/*
+ * Allocate an uppercase copy of a String.
+ */
+INH_string * str_to_upper_new (const INH_string * string) {
+    INH_string * new = str_alloc(string->len);
+    if (new == NULL) {
+        return new;
+    }
+    str__flip_case(new->buffer, string->buffer, string->len, 'a');
+    return new;
+}
+
+/*
+ * Remove leading and trailing whitespace from a String.
+ * Reallocates the string.
+ * Returns the string pointer.
+ */
+INH_string * str_trim (INH_string * string) {
+    if (str_is_shared(string)) {
+        // Copy and transform in one pass
+        INH_string * new = str_trim_new(string);
+        str_release(string);
+        return new;
+    }
+    size_t start, end;
+    str__trim_bounds(string, &start, &end);
+    if (start == 0 && end == string->len) {
+        return string;
+    }
+    memmove(string->buffer, string->buffer + start, end - start);
+    return str_realloc(string, end - start);
+}
+
+/*
+ * Allocate a copy of a String with leading and trailing whitespace removed.
+ */
+INH_string * str_trim_new (const INH_string * string) {
+    size_t start, end;
+    str__trim_bounds(string, &start, &end);
+    return str_new_sub(string, start, end);
+}
+
+/*
+ * Replace every occurrence of the character from with to, in place.
+ * Returns the string pointer.
+ */
+INH_string * str_replace_char (INH_string * string, char from, char to) {
+    if (str_is_shared(string)) {
+        // Copy and transform in one pass
+        INH_string * new = str_replace_char_new(string, from, to);
+        str_release(string);
+        return new;
+    }
+    str__replace_char(string->buffer, string->buffer, string->len, from, to);
+    return string;
+}
+
+/*
+ * Allocate a copy of a String with every occurrence of from replaced with to.
+ */
+INH_string * str_replace_char_new (const INH_string * string, char from, char to) {
+    INH_string * new = str_alloc(string->len);
+    if (new == NULL) {
+        return new;
+    }
+    str__replace_char(new->buffer, string->buffer, string->len, from, to);
+    return new;
+}
+
+/*
+ * Map every byte c of a String to table[c], in place.
+ * Returns the string pointer.
+ */
+INH_string * str_translate (INH_string * string, const unsigned char table[256]) {
+    if (str_is_shared(string)) {
+        // Copy and transform in one pass
+        INH_string * new = str_translate_new(string, table);
+        str_release(string);
+        return new;
+    }
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+        string->buffer[i] = table[(unsigned char)string->buffer[i]];
+    }
+    return string;
+}
+
+/*
+ * Allocate a copy of a String with every byte c mapped to table[c].
+ */
+INH_string * str_translate_new (const INH_string * string, const unsigned char table[256]) {
+    INH_string * new = str_alloc(string->len);
+    if (new == NULL) {
+        return new;
+    }
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+        new->buffer[i] = table[(unsigned char)string->buffer[i]];
+    }
+    return new;
+}
+
+/*
+ * Remove every byte c from a String for which keep[c] is false.
+ * Reallocates the string.
+ * Returns the string pointer.
+ */
+INH_string * str_filter (INH_string * string, const bool keep[256]) {
+    if (str_is_shared(string)) {
+        // Copy and transform in one pass
+        INH_string * new = str_filter_new(string, keep);
+        str_release(string);
+        return new;
+    }
+    size_t len = str__filter(string->buffer, string->buffer, string->len, keep);
+    if (len == string->len) {
+        return string;
+    }
+    return str_realloc(string, len);
+}
+
+/*
+ * Allocate a copy of a String with only the bytes c for which keep[c] is true.
+ */
+INH_string * str_filter_new (const INH_string * string, const bool keep[256]) {
+    INH_string * new = str_alloc(string->len);
+    if (new == NULL) {
+        return new;
+    }
+    size_t len = str__filter(new->buffer, string->buffer, string->len, keep);
+    if (len == new->len) {
+        return new;
+    }
+    return str_realloc(new, len);
+}
+
+/*
+ * View a whole String.
+ */
+INH_view str_view (const INH_string * string) {
+    INH_view view = { string->buffer, string->len };
+    return view;
+}
+
+/*
+ * View the substring start...end of a String.
+ * start is inclusive
+ * end is exclusive
+ */
+INH_view str_view_sub (const INH_string * string, size_t start, size_t end) {
+    assert(start <= end && end <= string->len);
+    INH_view view = { string->buffer + start, end - start };
+    return view;
+}
+
+/*
+ * View a C string, which must be null-terminated.
+ */
+INH_view str_view_cstr (const char * stream) {
+    INH_view view = { stream, strlen(stream) };
+    return view;
+}
+
+/*
+ * Append len characters to the end of a String.
+ * Reallocates the string.
+ * Returns the string pointer.
+ */
+static INH_string * str__append_chars (INH_string * string, const char * chars, size_t len) {
+    size_t orig_len = string->len;
+    string = str_realloc(string, orig_len + len);
+    memcpy(string->buffer + orig_len, chars, len);
+    return string;
+}
+
+static const char str__digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/*
+ * Write the decimal digits of value so that they end just before end,
+ * two digits at a time.
+ * Returns a pointer to the first digit.
+ */
+static char * str__format_u64 (char * end, uint64_t value) {
+    char * p = end;
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        p[0] = str__digit_pairs[pair];
+        p[1] = str__digit_pairs[pair + 1];
+    }
+    if (value >= 10) {
+        size_t pair = (size_t)value * 2;
+        p -= 2;
+        p[0] = str__digit_pairs[pair];
+        p[1] = str__digit_pairs[pair + 1];
+    } else {
+        *--p = (char)('0' + value);
+    }
+    return p;
+}
+
+/*
+ * Append the decimal form of an unsigned integer to a String.
+ * Reallocates the string.
+ * Returns the string pointer.
+ */
+INH_string * str_append_u64 (INH_string * string, uint64_t value) {
+    char buf[20];
+    char * start = str__format_u64(buf + sizeof(buf), value);
+    return str__append_chars(string, start, buf + sizeof(buf) - start);
+}
+
+/*
+ * Append the decimal form of a signed integer to a String.
+ * Reallocates the string.
+ * Returns the string pointer.
+ */
+INH_string * str_append_int (INH_string * string, int64_t value) {
+    char buf[21];
+    // Negate as unsigned so that the minimum value does not overflow
+    uint64_t magnitude = (value < 0) ? 0 - (uint64_t)value : (uint64_t)value;
+    char * start = str__format_u64(buf + sizeof(buf), magnitude);
+    if (value < 0) {
+        *--start = '-';
+    }
+    return str__append_chars(string, start, buf + sizeof(buf) - start);
+}
+
+/*
+ * 128-bit approximations of the powers of ten from 10^-292 to 10^324, as
+ * { high, low } words: ceil(10^k * 2^-e), with e chosen so that the top bit
+ * is set.
+ */
+static const uint64_t str__pow10_table[617][2] = {
+    { 0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7b }, { 0x9faacf3df73609b1, 0x77b191618c54e9ad },
+    { 0xc795830d75038c1d, 0xd59df5b9ef6a2418 }, { 0xf97ae3d0d2446f25, 0x4b0573286b44ad1e },
+    { 0x9becce62836ac577, 0x4ee367f9430aec33 }, { 0xc2e801fb244576d5, 0x229c41f793cda740 },
+    { 0xf3a20279ed56d48a, 0x6b43527578c11110 }, { 0x9845418c345644d6, 0x830a13896b78aaaa },
+    { 0xbe5691ef416bd60c, 0x23cc986bc656d554 }, { 0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa9 },
+    { 0x94b3a202eb1c3f39, 0x7bf7d71432f3d6aa }, { 0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc54 },
+    { 0xe858ad248f5c22c9, 0xd1b3400f8f9cff69 }, { 0x91376c36d99995be, 0x23100809b9c21fa2 },
+    { 0xb58547448ffffb2d, 0xabd40a0c2832a78b }, { 0xe2e69915b3fff9f9, 0x16c90c8f323f516d },
+    { 0x8dd01fad907ffc3b, 0xae3da7d97f6792e4 }, { 0xb1442798f49ffb4a, 0x99cd11cfdf41779d },
+    { 0xdd95317f31c7fa1d, 0x40405643d711d584 }, { 0x8a7d3eef7f1cfc52, 0x482835ea666b2573 },
+    { 0xad1c8eab5ee43b66, 0xda3243650005eed0 }, { 0xd863b256369d4a40, 0x90bed43e40076a83 },
+    { 0x873e4f75e2224e68, 0x5a7744a6e804a292 }, { 0xa90de3535aaae202, 0x711515d0a205cb37 },
+    { 0xd3515c2831559a83, 0x0d5a5b44ca873e04 }, { 0x8412d9991ed58091, 0xe858790afe9486c3 },
+    { 0xa5178fff668ae0b6, 0x626e974dbe39a873 }, { 0xce5d73ff402d98e3, 0xfb0a3d212dc81290 },
+    { 0x80fa687f881c7f8e, 0x7ce66634bc9d0b9a }, { 0xa139029f6a239f72, 0x1c1fffc1ebc44e81 },
+    { 0xc987434744ac874e, 0xa327ffb266b56221 }, { 0xfbe9141915d7a922, 0x4bf1ff9f0062baa9 },
+    { 0x9d71ac8fada6c9b5, 0x6f773fc3603db4aa }, { 0xc4ce17b399107c22, 0xcb550fb4384d21d4 },
+    { 0xf6019da07f549b2b, 0x7e2a53a146606a49 }, { 0x99c102844f94e0fb, 0x2eda7444cbfc426e },
+    { 0xc0314325637a1939, 0xfa911155fefb5309 }, { 0xf03d93eebc589f88, 0x793555ab7eba27cb },
+    { 0x96267c7535b763b5, 0x4bc1558b2f3458df }, { 0xbbb01b9283253ca2, 0x9eb1aaedfb016f17 },
+    { 0xea9c227723ee8bcb, 0x465e15a979c1cadd }, { 0x92a1958a7675175f, 0x0bfacd89ec191eca },
+    { 0xb749faed14125d36, 0xcef980ec671f667c }, { 0xe51c79a85916f484, 0x82b7e12780e7401b },
+    { 0x8f31cc0937ae58d2, 0xd1b2ecb8b0908811 }, { 0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa16 },
+    { 0xdfbdcece67006ac9, 0x67a791e093e1d49b }, { 0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e1 },
+    { 0xaecc49914078536d, 0x58fae9f773886e19 }, { 0xda7f5bf590966848, 0xaf39a475506a899f },
+    { 0x888f99797a5e012d, 0x6d8406c952429604 }, { 0xaab37fd7d8f58178, 0xc8e5087ba6d33b84 },
+    { 0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a65 }, { 0x855c3be0a17fcd26, 0x5cf2eea09a550680 },
+    { 0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481f }, { 0xd0601d8efc57b08b, 0xf13b94daf124da27 },
+    { 0x823c12795db6ce57, 0x76c53d08d6b70859 }, { 0xa2cb1717b52481ed, 0x54768c4b0c64ca6f },
+    { 0xcb7ddcdda26da268, 0xa9942f5dcf7dfd0a }, { 0xfe5d54150b090b02, 0xd3f93b35435d7c4d },
+    { 0x9efa548d26e5a6e1, 0xc47bc5014a1a6db0 }, { 0xc6b8e9b0709f109a, 0x359ab6419ca1091c },
+    { 0xf867241c8cc6d4c0, 0xc30163d203c94b63 }, { 0x9b407691d7fc44f8, 0x79e0de63425dcf1e },
+    { 0xc21094364dfb5636, 0x985915fc12f542e5 }, { 0xf294b943e17a2bc4, 0x3e6f5b7b17b2939e },
+    { 0x979cf3ca6cec5b5a, 0xa705992ceecf9c43 }, { 0xbd8430bd08277231, 0x50c6ff782a838354 },
+    { 0xece53cec4a314ebd, 0xa4f8bf5635246429 }, { 0x940f4613ae5ed136, 0x871b7795e136be9a },
+    { 0xb913179899f68584, 0x28e2557b59846e40 }, { 0xe757dd7ec07426e5, 0x331aeada2fe589d0 },
+    { 0x9096ea6f3848984f, 0x3ff0d2c85def7622 }, { 0xb4bca50b065abe63, 0x0fed077a756b53aa },
+    { 0xe1ebce4dc7f16dfb, 0xd3e8495912c62895 }, { 0x8d3360f09cf6e4bd, 0x64712dd7abbbd95d },
+    { 0xb080392cc4349dec, 0xbd8d794d96aacfb4 }, { 0xdca04777f541c567, 0xecf0d7a0fc5583a1 },
+    { 0x89e42caaf9491b60, 0xf41686c49db57245 }, { 0xac5d37d5b79b6239, 0x311c2875c522ced6 },
+    { 0xd77485cb25823ac7, 0x7d633293366b828c }, { 0x86a8d39ef77164bc, 0xae5dff9c02033198 },
+    { 0xa8530886b54dbdeb, 0xd9f57f830283fdfd }, { 0xd267caa862a12d66, 0xd072df63c324fd7c },
+    { 0x8380dea93da4bc60, 0x4247cb9e59f71e6e }, { 0xa46116538d0deb78, 0x52d9be85f074e609 },
+    { 0xcd795be870516656, 0x67902e276c921f8c }, { 0x806bd9714632dff6, 0x00ba1cd8a3db53b7 },
+    { 0xa086cfcd97bf97f3, 0x80e8a40eccd228a5 }, { 0xc8a883c0fdaf7df0, 0x6122cd128006b2ce },
+    { 0xfad2a4b13d1b5d6c, 0x796b805720085f82 }, { 0x9cc3a6eec6311a63, 0xcbe3303674053bb1 },
+    { 0xc3f490aa77bd60fc, 0xbedbfc4411068a9d }, { 0xf4f1b4d515acb93b, 0xee92fb5515482d45 },
+    { 0x991711052d8bf3c5, 0x751bdd152d4d1c4b }, { 0xbf5cd54678eef0b6, 0xd262d45a78a0635e },
+    { 0xef340a98172aace4, 0x86fb897116c87c35 }, { 0x9580869f0e7aac0e, 0xd45d35e6ae3d4da1 },
+    { 0xbae0a846d2195712, 0x8974836059cca10a }, { 0xe998d258869facd7, 0x2bd1a438703fc94c },
+    { 0x91ff83775423cc06, 0x7b6306a34627ddd0 }, { 0xb67f6455292cbf08, 0x1a3bc84c17b1d543 },
+    { 0xe41f3d6a7377eeca, 0x20caba5f1d9e4a94 }, { 0x8e938662882af53e, 0x547eb47b7282ee9d },
+    { 0xb23867fb2a35b28d, 0xe99e619a4f23aa44 }, { 0xdec681f9f4c31f31, 0x6405fa00e2ec94d5 },
+    { 0x8b3c113c38f9f37e, 0xde83bc408dd3dd05 }, { 0xae0b158b4738705e, 0x9624ab50b148d446 },
+    { 0xd98ddaee19068c76, 0x3badd624dd9b0958 }, { 0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d7 },
+    { 0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4d }, { 0xd47487cc8470652b, 0x7647c32000696720 },
+    { 0x84c8d4dfd2c63f3b, 0x29ecd9f40041e074 }, { 0xa5fb0a17c777cf09, 0xf468107100525891 },
+    { 0xcf79cc9db955c2cc, 0x7182148d4066eeb5 }, { 0x81ac1fe293d599bf, 0xc6f14cd848405531 },
+    { 0xa21727db38cb002f, 0xb8ada00e5a506a7d }, { 0xca9cf1d206fdc03b, 0xa6d90811f0e4851d },
+    { 0xfd442e4688bd304a, 0x908f4a166d1da664 }, { 0x9e4a9cec15763e2e, 0x9a598e4e043287ff },
+    { 0xc5dd44271ad3cdba, 0x40eff1e1853f29fe }, { 0xf7549530e188c128, 0xd12bee59e68ef47d },
+    { 0x9a94dd3e8cf578b9, 0x82bb74f8301958cf }, { 0xc13a148e3032d6e7, 0xe36a52363c1faf02 },
+    { 0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac2 }, { 0x96f5600f15a7b7e5, 0x29ab103a5ef8c0ba },
+    { 0xbcb2b812db11a5de, 0x7415d448f6b6f0e8 }, { 0xebdf661791d60f56, 0x111b495b3464ad22 },
+    { 0x936b9fcebb25c995, 0xcab10dd900beec35 }, { 0xb84687c269ef3bfb, 0x3d5d514f40eea743 },
+    { 0xe65829b3046b0afa, 0x0cb4a5a3112a5113 }, { 0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ac },
+    { 0xb3f4e093db73a093, 0x59ed216765690f57 }, { 0xe0f218b8d25088b8, 0x306869c13ec3532d },
+    { 0x8c974f7383725573, 0x1e414218c73a13fc }, { 0xafbd2350644eeacf, 0xe5d1929ef90898fb },
+    { 0xdbac6c247d62a583, 0xdf45f746b74abf3a }, { 0x894bc396ce5da772, 0x6b8bba8c328eb784 },
+    { 0xab9eb47c81f5114f, 0x066ea92f3f326565 }, { 0xd686619ba27255a2, 0xc80a537b0efefebe },
+    { 0x8613fd0145877585, 0xbd06742ce95f5f37 }, { 0xa798fc4196e952e7, 0x2c48113823b73705 },
+    { 0xd17f3b51fca3a7a0, 0xf75a15862ca504c6 }, { 0x82ef85133de648c4, 0x9a984d73dbe722fc },
+    { 0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebbb }, { 0xcc963fee10b7d1b3, 0x318df905079926a9 },
+    { 0xffbbcfe994e5c61f, 0xfdf17746497f7053 }, { 0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa634 },
+    { 0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc1 }, { 0xf9bd690a1b68637b, 0x3dfdce7aa3c673b1 },
+    { 0x9c1661a651213e2d, 0x06bea10ca65c084f }, { 0xc31bfa0fe5698db8, 0x486e494fcff30a63 },
+    { 0xf3e2f893dec3f126, 0x5a89dba3c3efccfb }, { 0x986ddb5c6b3a76b7, 0xf89629465a75e01d },
+    { 0xbe89523386091465, 0xf6bbb397f1135824 }, { 0xee2ba6c0678b597f, 0x746aa07ded582e2d },
+    { 0x94db483840b717ef, 0xa8c2a44eb4571cdd }, { 0xba121a4650e4ddeb, 0x92f34d62616ce414 },
+    { 0xe896a0d7e51e1566, 0x77b020baf9c81d18 }, { 0x915e2486ef32cd60, 0x0ace1474dc1d122f },
+    { 0xb5b5ada8aaff80b8, 0x0d819992132456bb }, { 0xe3231912d5bf60e6, 0x10e1fff697ed6c6a },
+    { 0x8df5efabc5979c8f, 0xca8d3ffa1ef463c2 }, { 0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb3 },
+    { 0xddd0467c64bce4a0, 0xac7cb3f6d05ddbdf }, { 0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96c },
+    { 0xad4ab7112eb3929d, 0x86c16c98d2c953c7 }, { 0xd89d64d57a607744, 0xe871c7bf077ba8b8 },
+    { 0x87625f056c7c4a8b, 0x11471cd764ad4973 }, { 0xa93af6c6c79b5d2d, 0xd598e40d3dd89bd0 },
+    { 0xd389b47879823479, 0x4aff1d108d4ec2c4 }, { 0x843610cb4bf160cb, 0xcedf722a585139bb },
+    { 0xa54394fe1eedb8fe, 0xc2974eb4ee658829 }, { 0xce947a3da6a9273e, 0x733d226229feea33 },
+    { 0x811ccc668829b887, 0x0806357d5a3f5260 }, { 0xa163ff802a3426a8, 0xca07c2dcb0cf26f8 },
+    { 0xc9bcff6034c13052, 0xfc89b393dd02f0b6 }, { 0xfc2c3f3841f17c67, 0xbbac2078d443ace3 },
+    { 0x9d9ba7832936edc0, 0xd54b944b84aa4c0e }, { 0xc5029163f384a931, 0x0a9e795e65d4df12 },
+    { 0xf64335bcf065d37d, 0x4d4617b5ff4a16d6 }, { 0x99ea0196163fa42e, 0x504bced1bf8e4e46 },
+    { 0xc06481fb9bcf8d39, 0xe45ec2862f71e1d7 }, { 0xf07da27a82c37088, 0x5d767327bb4e5a4d },
+    { 0x964e858c91ba2655, 0x3a6a07f8d510f870 }, { 0xbbe226efb628afea, 0x890489f70a55368c },
+    { 0xeadab0aba3b2dbe5, 0x2b45ac74ccea842f }, { 0x92c8ae6b464fc96f, 0x3b0b8bc90012929e },
+    { 0xb77ada0617e3bbcb, 0x09ce6ebb40173745 }, { 0xe55990879ddcaabd, 0xcc420a6a101d0516 },
+    { 0x8f57fa54c2a9eab6, 0x9fa946824a12232e }, { 0xb32df8e9f3546564, 0x47939822dc96abfa },
+    { 0xdff9772470297ebd, 0x59787e2b93bc56f8 }, { 0x8bfbea76c619ef36, 0x57eb4edb3c55b65b },
+    { 0xaefae51477a06b03, 0xede622920b6b23f2 }, { 0xdab99e59958885c4, 0xe95fab368e45ecee },
+    { 0x88b402f7fd75539b, 0x11dbcb0218ebb415 }, { 0xaae103b5fcd2a881, 0xd652bdc29f26a11a },
+    { 0xd59944a37c0752a2, 0x4be76d3346f04960 }, { 0x857fcae62d8493a5, 0x6f70a4400c562ddc },
+    { 0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb953 }, { 0xd097ad07a71f26b2, 0x7e2000a41346a7a8 },
+    { 0x825ecc24c873782f, 0x8ed400668c0c28c9 }, { 0xa2f67f2dfa90563b, 0x728900802f0f32fb },
+    { 0xcbb41ef979346bca, 0x4f2b40a03ad2ffba }, { 0xfea126b7d78186bc, 0xe2f610c84987bfa9 },
+    { 0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7ca }, { 0xc6ede63fa05d3143, 0x91503d1c79720dbc },
+    { 0xf8a95fcf88747d94, 0x75a44c6397ce912b }, { 0x9b69dbe1b548ce7c, 0xc986afbe3ee11abb },
+    { 0xc24452da229b021b, 0xfbe85badce996169 }, { 0xf2d56790ab41c2a2, 0xfae27299423fb9c4 },
+    { 0x97c560ba6b0919a5, 0xdccd879fc967d41b }, { 0xbdb6b8e905cb600f, 0x5400e987bbc1c921 },
+    { 0xed246723473e3813, 0x290123e9aab23b69 }, { 0x9436c0760c86e30b, 0xf9a0b6720aaf6522 },
+    { 0xb94470938fa89bce, 0xf808e40e8d5b3e6a }, { 0xe7958cb87392c2c2, 0xb60b1d1230b20e05 },
+    { 0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c3 }, { 0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af4 },
+    { 0xe2280b6c20dd5232, 0x25c6da63c38de1b1 }, { 0x8d590723948a535f, 0x579c487e5a38ad0f },
+    { 0xb0af48ec79ace837, 0x2d835a9df0c6d852 }, { 0xdcdb1b2798182244, 0xf8e431456cf88e66 },
+    { 0x8a08f0f8bf0f156b, 0x1b8e9ecb641b5900 }, { 0xac8b2d36eed2dac5, 0xe272467e3d222f40 },
+    { 0xd7adf884aa879177, 0x5b0ed81dcc6abb10 }, { 0x86ccbb52ea94baea, 0x98e947129fc2b4ea },
+    { 0xa87fea27a539e9a5, 0x3f2398d747b36225 }, { 0xd29fe4b18e88640e, 0x8eec7f0d19a03aae },
+    { 0x83a3eeeef9153e89, 0x1953cf68300424ad }, { 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd8 },
+    { 0xcdb02555653131b6, 0x3792f412cb06794e }, { 0x808e17555f3ebf11, 0xe2bbd88bbee40bd1 },
+    { 0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec5 }, { 0xc8de047564d20a8b, 0xf245825a5a445276 },
+    { 0xfb158592be068d2e, 0xeed6e2f0f0d56713 }, { 0x9ced737bb6c4183d, 0x55464dd69685606c },
+    { 0xc428d05aa4751e4c, 0xaa97e14c3c26b887 }, { 0xf53304714d9265df, 0xd53dd99f4b3066a9 },
+    { 0x993fe2c6d07b7fab, 0xe546a8038efe402a }, { 0xbf8fdb78849a5f96, 0xde98520472bdd034 },
+    { 0xef73d256a5c0f77c, 0x963e66858f6d4441 }, { 0x95a8637627989aad, 0xdde7001379a44aa9 },
+    { 0xbb127c53b17ec159, 0x5560c018580d5d53 }, { 0xe9d71b689dde71af, 0xaab8f01e6e10b4a7 },
+    { 0x9226712162ab070d, 0xcab3961304ca70e9 }, { 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d23 },
+    { 0xe45c10c42a2b3b05, 0x8cb89a7db77c506b }, { 0x8eb98a7a9a5b04e3, 0x77f3608e92adb243 },
+    { 0xb267ed1940f1c61c, 0x55f038b237591ed4 }, { 0xdf01e85f912e37a3, 0x6b6c46dec52f6689 },
+    { 0x8b61313bbabce2c6, 0x2323ac4b3b3da016 }, { 0xae397d8aa96c1b77, 0xabec975e0a0d081b },
+    { 0xd9c7dced53c72255, 0x96e7bd358c904a22 }, { 0x881cea14545c7575, 0x7e50d64177da2e55 },
+    { 0xaa242499697392d2, 0xdde50bd1d5d0b9ea }, { 0xd4ad2dbfc3d07787, 0x955e4ec64b44e865 },
+    { 0x84ec3c97da624ab4, 0xbd5af13bef0b113f }, { 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58f },
+    { 0xcfb11ead453994ba, 0x67de18eda5814af3 }, { 0x81ceb32c4b43fcf4, 0x80eacf948770ced8 },
+    { 0xa2425ff75e14fc31, 0xa1258379a94d028e }, { 0xcad2f7f5359a3b3e, 0x096ee45813a04331 },
+    { 0xfd87b5f28300ca0d, 0x8bca9d6e188853fd }, { 0x9e74d1b791e07e48, 0x775ea264cf55347e },
+    { 0xc612062576589dda, 0x95364afe032a819e }, { 0xf79687aed3eec551, 0x3a83ddbd83f52205 },
+    { 0x9abe14cd44753b52, 0xc4926a9672793543 }, { 0xc16d9a0095928a27, 0x75b7053c0f178294 },
+    { 0xf1c90080baf72cb1, 0x5324c68b12dd6339 }, { 0x971da05074da7bee, 0xd3f6fc16ebca5e04 },
+    { 0xbce5086492111aea, 0x88f4bb1ca6bcf585 }, { 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6 },
+    { 0x9392ee8e921d5d07, 0x3aff322e62439fd0 }, { 0xb877aa3236a4b449, 0x09befeb9fad487c3 },
+    { 0xe69594bec44de15b, 0x4c2ebe687989a9b4 }, { 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11 },
+    { 0xb424dc35095cd80f, 0x538484c19ef38c95 }, { 0xe12e13424bb40e13, 0x2865a5f206b06fba },
+    { 0x8cbccc096f5088cb, 0xf93f87b7442e45d4 }, { 0xafebff0bcb24aafe, 0xf78f69a51539d749 },
+    { 0xdbe6fecebdedd5be, 0xb573440e5a884d1c }, { 0x89705f4136b4a597, 0x31680a88f8953031 },
+    { 0xabcc77118461cefc, 0xfdc20d2b36ba7c3e }, { 0xd6bf94d5e57a42bc, 0x3d32907604691b4d },
+    { 0x8637bd05af6c69b5, 0xa63f9a49c2c1b110 }, { 0xa7c5ac471b478423, 0x0fcf80dc33721d54 },
+    { 0xd1b71758e219652b, 0xd3c36113404ea4a9 }, { 0x83126e978d4fdf3b, 0x645a1cac083126ea },
+    { 0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4 }, { 0xcccccccccccccccc, 0xcccccccccccccccd },
+    { 0x8000000000000000, 0x0000000000000000 }, { 0xa000000000000000, 0x0000000000000000 },
+    { 0xc800000000000000, 0x0000000000000000 }, { 0xfa00000000000000, 0x0000000000000000 },
+    { 0x9c40000000000000, 0x0000000000000000 }, { 0xc350000000000000, 0x0000000000000000 },
+    { 0xf424000000000000, 0x0000000000000000 }, { 0x9896800000000000, 0x0000000000000000 },
+    { 0xbebc200000000000, 0x0000000000000000 }, { 0xee6b280000000000, 0x0000000000000000 },
+    { 0x9502f90000000000, 0x0000000000000000 }, { 0xba43b74000000000, 0x0000000000000000 },
+    { 0xe8d4a51000000000, 0x0000000000000000 }, { 0x9184e72a00000000, 0x0000000000000000 },
+    { 0xb5e620f480000000, 0x0000000000000000 }, { 0xe35fa931a0000000, 0x0000000000000000 },
+    { 0x8e1bc9bf04000000, 0x0000000000000000 }, { 0xb1a2bc2ec5000000, 0x0000000000000000 },
+    { 0xde0b6b3a76400000, 0x0000000000000000 }, { 0x8ac7230489e80000, 0x0000000000000000 },
+    { 0xad78ebc5ac620000, 0x0000000000000000 }, { 0xd8d726b7177a8000, 0x0000000000000000 },
+    { 0x878678326eac9000, 0x0000000000000000 }, { 0xa968163f0a57b400, 0x0000000000000000 },
+    { 0xd3c21bcecceda100, 0x0000000000000000 }, { 0x84595161401484a0, 0x0000000000000000 },
+    { 0xa56fa5b99019a5c8, 0x0000000000000000 }, { 0xcecb8f27f4200f3a, 0x0000000000000000 },
+    { 0x813f3978f8940984, 0x4000000000000000 }, { 0xa18f07d736b90be5, 0x5000000000000000 },
+    { 0xc9f2c9cd04674ede, 0xa400000000000000 }, { 0xfc6f7c4045812296, 0x4d00000000000000 },
+    { 0x9dc5ada82b70b59d, 0xf020000000000000 }, { 0xc5371912364ce305, 0x6c28000000000000 },
+    { 0xf684df56c3e01bc6, 0xc732000000000000 }, { 0x9a130b963a6c115c, 0x3c7f400000000000 },
+    { 0xc097ce7bc90715b3, 0x4b9f100000000000 }, { 0xf0bdc21abb48db20, 0x1e86d40000000000 },
+    { 0x96769950b50d88f4, 0x1314448000000000 }, { 0xbc143fa4e250eb31, 0x17d955a000000000 },
+    { 0xeb194f8e1ae525fd, 0x5dcfab0800000000 }, { 0x92efd1b8d0cf37be, 0x5aa1cae500000000 },
+    { 0xb7abc627050305ad, 0xf14a3d9e40000000 }, { 0xe596b7b0c643c719, 0x6d9ccd05d0000000 },
+    { 0x8f7e32ce7bea5c6f, 0xe4820023a2000000 }, { 0xb35dbf821ae4f38b, 0xdda2802c8a800000 },
+    { 0xe0352f62a19e306e, 0xd50b2037ad200000 }, { 0x8c213d9da502de45, 0x4526f422cc340000 },
+    { 0xaf298d050e4395d6, 0x9670b12b7f410000 }, { 0xdaf3f04651d47b4c, 0x3c0cdd765f114000 },
+    { 0x88d8762bf324cd0f, 0xa5880a69fb6ac800 }, { 0xab0e93b6efee0053, 0x8eea0d047a457a00 },
+    { 0xd5d238a4abe98068, 0x72a4904598d6d880 }, { 0x85a36366eb71f041, 0x47a6da2b7f864750 },
+    { 0xa70c3c40a64e6c51, 0x999090b65f67d924 }, { 0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d },
+    { 0x82818f1281ed449f, 0xbff8f10e7a8921a5 }, { 0xa321f2d7226895c7, 0xaff72d52192b6a0e },
+    { 0xcbea6f8ceb02bb39, 0x9bf4f8a69f764491 }, { 0xfee50b7025c36a08, 0x02f236d04753d5b5 },
+    { 0x9f4f2726179a2245, 0x01d762422c946591 }, { 0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef6 },
+    { 0xf8ebad2b84e0d58b, 0xd2e0898765a7deb3 }, { 0x9b934c3b330c8577, 0x63cc55f49f88eb30 },
+    { 0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fc }, { 0xf316271c7fc3908a, 0x8bef464e3945ef7b },
+    { 0x97edd871cfda3a56, 0x97758bf0e3cbb5ad }, { 0xbde94e8e43d0c8ec, 0x3d52eeed1cbea318 },
+    { 0xed63a231d4c4fb27, 0x4ca7aaa863ee4bde }, { 0x945e455f24fb1cf8, 0x8fe8caa93e74ef6b },
+    { 0xb975d6b6ee39e436, 0xb3e2fd538e122b45 }, { 0xe7d34c64a9c85d44, 0x60dbbca87196b617 },
+    { 0x90e40fbeea1d3a4a, 0xbc8955e946fe31ce }, { 0xb51d13aea4a488dd, 0x6babab6398bdbe42 },
+    { 0xe264589a4dcdab14, 0xc696963c7eed2dd2 }, { 0x8d7eb76070a08aec, 0xfc1e1de5cf543ca3 },
+    { 0xb0de65388cc8ada8, 0x3b25a55f43294bcc }, { 0xdd15fe86affad912, 0x49ef0eb713f39ebf },
+    { 0x8a2dbf142dfcc7ab, 0x6e3569326c784338 }, { 0xacb92ed9397bf996, 0x49c2c37f07965405 },
+    { 0xd7e77a8f87daf7fb, 0xdc33745ec97be907 }, { 0x86f0ac99b4e8dafd, 0x69a028bb3ded71a4 },
+    { 0xa8acd7c0222311bc, 0xc40832ea0d68ce0d }, { 0xd2d80db02aabd62b, 0xf50a3fa490c30191 },
+    { 0x83c7088e1aab65db, 0x792667c6da79e0fb }, { 0xa4b8cab1a1563f52, 0x577001b891185939 },
+    { 0xcde6fd5e09abcf26, 0xed4c0226b55e6f87 }, { 0x80b05e5ac60b6178, 0x544f8158315b05b5 },
+    { 0xa0dc75f1778e39d6, 0x696361ae3db1c722 }, { 0xc913936dd571c84c, 0x03bc3a19cd1e38ea },
+    { 0xfb5878494ace3a5f, 0x04ab48a04065c724 }, { 0x9d174b2dcec0e47b, 0x62eb0d64283f9c77 },
+    { 0xc45d1df942711d9a, 0x3ba5d0bd324f8395 }, { 0xf5746577930d6500, 0xca8f44ec7ee3647a },
+    { 0x9968bf6abbe85f20, 0x7e998b13cf4e1ecc }, { 0xbfc2ef456ae276e8, 0x9e3fedd8c321a67f },
+    { 0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101f }, { 0x95d04aee3b80ece5, 0xbba1f1d158724a13 },
+    { 0xbb445da9ca61281f, 0x2a8a6e45ae8edc98 }, { 0xea1575143cf97226, 0xf52d09d71a3293be },
+    { 0x924d692ca61be758, 0x593c2626705f9c57 }, { 0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836d },
+    { 0xe498f455c38b997a, 0x0b6dfb9c0f956448 }, { 0x8edf98b59a373fec, 0x4724bd4189bd5ead },
+    { 0xb2977ee300c50fe7, 0x58edec91ec2cb658 }, { 0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ee },
+    { 0x8b865b215899f46c, 0xbd79e0d20082ee75 }, { 0xae67f1e9aec07187, 0xecd8590680a3aa12 },
+    { 0xda01ee641a708de9, 0xe80e6f4820cc9496 }, { 0x884134fe908658b2, 0x3109058d147fdcde },
+    { 0xaa51823e34a7eede, 0xbd4b46f0599fd416 }, { 0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91b },
+    { 0x850fadc09923329e, 0x03e2cf6bc604ddb1 }, { 0xa6539930bf6bff45, 0x84db8346b786151d },
+    { 0xcfe87f7cef46ff16, 0xe612641865679a64 }, { 0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07f },
+    { 0xa26da3999aef7749, 0xe3be5e330f38f09e }, { 0xcb090c8001ab551c, 0x5cadf5bfd3072cc6 },
+    { 0xfdcb4fa002162a63, 0x73d9732fc7c8f7f7 }, { 0x9e9f11c4014dda7e, 0x2867e7fddcdd9afb },
+    { 0xc646d63501a1511d, 0xb281e1fd541501b9 }, { 0xf7d88bc24209a565, 0x1f225a7ca91a4227 },
+    { 0x9ae757596946075f, 0x3375788de9b06959 }, { 0xc1a12d2fc3978937, 0x0052d6b1641c83af },
+    { 0xf209787bb47d6b84, 0xc0678c5dbd23a49b }, { 0x9745eb4d50ce6332, 0xf840b7ba963646e1 },
+    { 0xbd176620a501fbff, 0xb650e5a93bc3d899 }, { 0xec5d3fa8ce427aff, 0xa3e51f138ab4cebf },
+    { 0x93ba47c980e98cdf, 0xc66f336c36b10138 }, { 0xb8a8d9bbe123f017, 0xb80b0047445d4185 },
+    { 0xe6d3102ad96cec1d, 0xa60dc059157491e6 }, { 0x9043ea1ac7e41392, 0x87c89837ad68db30 },
+    { 0xb454e4a179dd1877, 0x29babe4598c311fc }, { 0xe16a1dc9d8545e94, 0xf4296dd6fef3d67b },
+    { 0x8ce2529e2734bb1d, 0x1899e4a65f58660d }, { 0xb01ae745b101e9e4, 0x5ec05dcff72e7f90 },
+    { 0xdc21a1171d42645d, 0x76707543f4fa1f74 }, { 0x899504ae72497eba, 0x6a06494a791c53a9 },
+    { 0xabfa45da0edbde69, 0x0487db9d17636893 }, { 0xd6f8d7509292d603, 0x45a9d2845d3c42b7 },
+    { 0x865b86925b9bc5c2, 0x0b8a2392ba45a9b3 }, { 0xa7f26836f282b732, 0x8e6cac7768d7141f },
+    { 0xd1ef0244af2364ff, 0x3207d795430cd927 }, { 0x8335616aed761f1f, 0x7f44e6bd49e807b9 },
+    { 0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a7 }, { 0xcd036837130890a1, 0x36dba887c37a8c10 },
+    { 0x802221226be55a64, 0xc2494954da2c978a }, { 0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6d },
+    { 0xc83553c5c8965d3d, 0x6f92829494e5acc8 }, { 0xfa42a8b73abbf48c, 0xcb772339ba1f17fa },
+    { 0x9c69a97284b578d7, 0xff2a760414536efc }, { 0xc38413cf25e2d70d, 0xfef5138519684abb },
+    { 0xf46518c2ef5b8cd1, 0x7eb258665fc25d6a }, { 0x98bf2f79d5993802, 0xef2f773ffbd97a62 },
+    { 0xbeeefb584aff8603, 0xaafb550ffacfd8fb }, { 0xeeaaba2e5dbf6784, 0x95ba2a53f983cf39 },
+    { 0x952ab45cfa97a0b2, 0xdd945a747bf26184 }, { 0xba756174393d88df, 0x94f971119aeef9e5 },
+    { 0xe912b9d1478ceb17, 0x7a37cd5601aab85e }, { 0x91abb422ccb812ee, 0xac62e055c10ab33b },
+    { 0xb616a12b7fe617aa, 0x577b986b314d600a }, { 0xe39c49765fdf9d94, 0xed5a7e85fda0b80c },
+    { 0x8e41ade9fbebc27d, 0x14588f13be847308 }, { 0xb1d219647ae6b31c, 0x596eb2d8ae258fc9 },
+    { 0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bc }, { 0x8aec23d680043bee, 0x25de7bb9480d5855 },
+    { 0xada72ccc20054ae9, 0xaf561aa79a10ae6b }, { 0xd910f7ff28069da4, 0x1b2ba1518094da05 },
+    { 0x87aa9aff79042286, 0x90fb44d2f05d0843 }, { 0xa99541bf57452b28, 0x353a1607ac744a54 },
+    { 0xd3fa922f2d1675f2, 0x42889b8997915ce9 }, { 0x847c9b5d7c2e09b7, 0x69956135febada12 },
+    { 0xa59bc234db398c25, 0x43fab9837e699096 }, { 0xcf02b2c21207ef2e, 0x94f967e45e03f4bc },
+    { 0x8161afb94b44f57d, 0x1d1be0eebac278f6 }, { 0xa1ba1ba79e1632dc, 0x6462d92a69731733 },
+    { 0xca28a291859bbf93, 0x7d7b8f7503cfdcff }, { 0xfcb2cb35e702af78, 0x5cda735244c3d43f },
+    { 0x9defbf01b061adab, 0x3a0888136afa64a8 }, { 0xc56baec21c7a1916, 0x088aaa1845b8fdd1 },
+    { 0xf6c69a72a3989f5b, 0x8aad549e57273d46 }, { 0x9a3c2087a63f6399, 0x36ac54e2f678864c },
+    { 0xc0cb28a98fcf3c7f, 0x84576a1bb416a7de }, { 0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d6 },
+    { 0x969eb7c47859e743, 0x9f644ae5a4b1b326 }, { 0xbc4665b596706114, 0x873d5d9f0dde1fef },
+    { 0xeb57ff22fc0c7959, 0xa90cb506d155a7eb }, { 0x9316ff75dd87cbd8, 0x09a7f12442d588f3 },
+    { 0xb7dcbf5354e9bece, 0x0c11ed6d538aeb30 }, { 0xe5d3ef282a242e81, 0x8f1668c8a86da5fb },
+    { 0x8fa475791a569d10, 0xf96e017d694487bd }, { 0xb38d92d760ec4455, 0x37c981dcc395a9ad },
+    { 0xe070f78d3927556a, 0x85bbe253f47b1418 }, { 0x8c469ab843b89562, 0x93956d7478ccec8f },
+    { 0xaf58416654a6babb, 0x387ac8d1970027b3 }, { 0xdb2e51bfe9d0696a, 0x06997b05fcc0319f },
+    { 0x88fcf317f22241e2, 0x441fece3bdf81f04 }, { 0xab3c2fddeeaad25a, 0xd527e81cad7626c4 },
+    { 0xd60b3bd56a5586f1, 0x8a71e223d8d3b075 }, { 0x85c7056562757456, 0xf6872d5667844e4a },
+    { 0xa738c6bebb12d16c, 0xb428f8ac016561dc }, { 0xd106f86e69d785c7, 0xe13336d701beba53 },
+    { 0x82a45b450226b39c, 0xecc0024661173474 }, { 0xa34d721642b06084, 0x27f002d7f95d0191 },
+    { 0xcc20ce9bd35c78a5, 0x31ec038df7b441f5 }, { 0xff290242c83396ce, 0x7e67047175a15272 },
+    { 0x9f79a169bd203e41, 0x0f0062c6e984d387 }, { 0xc75809c42c684dd1, 0x52c07b78a3e60869 },
+    { 0xf92e0c3537826145, 0xa7709a56ccdf8a83 }, { 0x9bbcc7a142b17ccb, 0x88a66076400bb692 },
+    { 0xc2abf989935ddbfe, 0x6acff893d00ea436 }, { 0xf356f7ebf83552fe, 0x0583f6b8c4124d44 },
+    { 0x98165af37b2153de, 0xc3727a337a8b704b }, { 0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5d },
+    { 0xeda2ee1c7064130c, 0x1162def06f79df74 }, { 0x9485d4d1c63e8be7, 0x8addcb5645ac2ba9 },
+    { 0xb9a74a0637ce2ee1, 0x6d953e2bd7173693 }, { 0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0438 },
+    { 0x910ab1d4db9914a0, 0x1d9c9892400a22a3 }, { 0xb54d5e4a127f59c8, 0x2503beb6d00cab4c },
+    { 0xe2a0b5dc971f303a, 0x2e44ae64840fd61e }, { 0x8da471a9de737e24, 0x5ceaecfed289e5d3 },
+    { 0xb10d8e1456105dad, 0x7425a83e872c5f48 }, { 0xdd50f1996b947518, 0xd12f124e28f7771a },
+    { 0x8a5296ffe33cc92f, 0x82bd6b70d99aaa70 }, { 0xace73cbfdc0bfb7b, 0x636cc64d1001550c },
+    { 0xd8210befd30efa5a, 0x3c47f7e05401aa4f }, { 0x8714a775e3e95c78, 0x65acfaec34810a72 },
+    { 0xa8d9d1535ce3b396, 0x7f1839a741a14d0e }, { 0xd31045a8341ca07c, 0x1ede48111209a051 },
+    { 0x83ea2b892091e44d, 0x934aed0aab460433 }, { 0xa4e4b66b68b65d60, 0xf81da84d56178540 },
+    { 0xce1de40642e3f4b9, 0x36251260ab9d668f }, { 0x80d2ae83e9ce78f3, 0xc1d72b7c6b42601a },
+    { 0xa1075a24e4421730, 0xb24cf65b8612f820 }, { 0xc94930ae1d529cfc, 0xdee033f26797b628 },
+    { 0xfb9b7cd9a4a7443c, 0x169840ef017da3b2 }, { 0x9d412e0806e88aa5, 0x8e1f289560ee864f },
+    { 0xc491798a08a2ad4e, 0xf1a6f2bab92a27e3 }, { 0xf5b5d7ec8acb58a2, 0xae10af696774b1dc },
+    { 0x9991a6f3d6bf1765, 0xacca6da1e0a8ef2a }, { 0xbff610b0cc6edd3f, 0x17fd090a58d32af4 },
+    { 0xeff394dcff8a948e, 0xddfc4b4cef07f5b1 }, { 0x95f83d0a1fb69cd9, 0x4abdaf101564f98f },
+    { 0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f2 }, { 0xea53df5fd18d5513, 0x84c86189216dc5ee },
+    { 0x92746b9be2f8552c, 0x32fd3cf5b4e49bb5 }, { 0xb7118682dbb66a77, 0x3fbc8c33221dc2a2 },
+    { 0xe4d5e82392a40515, 0x0fabaf3feaa5334b }, { 0x8f05b1163ba6832d, 0x29cb4d87f2a7400f },
+    { 0xb2c71d5bca9023f8, 0x743e20e9ef511013 }, { 0xdf78e4b2bd342cf6, 0x914da9246b255417 },
+    { 0x8bab8eefb6409c1a, 0x1ad089b6c2f7548f }, { 0xae9672aba3d0c320, 0xa184ac2473b529b2 },
+    { 0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741f }, { 0x8865899617fb1871, 0x7e2fa67c7a658893 },
+    { 0xaa7eebfb9df9de8d, 0xddbb901b98feeab8 }, { 0xd51ea6fa85785631, 0x552a74227f3ea566 },
+    { 0x8533285c936b35de, 0xd53a88958f872760 }, { 0xa67ff273b8460356, 0x8a892abaf368f138 },
+    { 0xd01fef10a657842c, 0x2d2b7569b0432d86 }, { 0x8213f56a67f6b29b, 0x9c3b29620e29fc74 },
+    { 0xa298f2c501f45f42, 0x8349f3ba91b47b90 }, { 0xcb3f2f7642717713, 0x241c70a936219a74 },
+    { 0xfe0efb53d30dd4d7, 0xed238cd383aa0111 }, { 0x9ec95d1463e8a506, 0xf4363804324a40ab },
+    { 0xc67bb4597ce2ce48, 0xb143c6053edcd0d6 }, { 0xf81aa16fdc1b81da, 0xdd94b7868e94050b },
+    { 0x9b10a4e5e9913128, 0xca7cf2b4191c8327 }, { 0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f1 },
+    { 0xf24a01a73cf2dccf, 0xbc633b39673c8ced }, { 0x976e41088617ca01, 0xd5be0503e085d814 },
+    { 0xbd49d14aa79dbc82, 0x4b2d8644d8a74e19 }, { 0xec9c459d51852ba2, 0xddf8e7d60ed1219f },
+    { 0x93e1ab8252f33b45, 0xcabb90e5c942b504 }, { 0xb8da1662e7b00a17, 0x3d6a751f3b936244 },
+    { 0xe7109bfba19c0c9d, 0x0cc512670a783ad5 }, { 0x906a617d450187e2, 0x27fb2b80668b24c6 },
+    { 0xb484f9dc9641e9da, 0xb1f9f660802dedf7 }, { 0xe1a63853bbd26451, 0x5e7873f8a0396974 },
+    { 0x8d07e33455637eb2, 0xdb0b487b6423e1e9 }, { 0xb049dc016abc5e5f, 0x91ce1a9a3d2cda63 },
+    { 0xdc5c5301c56b75f7, 0x7641a140cc7810fc }, { 0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9e },
+    { 0xac2820d9623bf429, 0x546345fa9fbdcd45 }, { 0xd732290fbacaf133, 0xa97c177947ad4096 },
+    { 0x867f59a9d4bed6c0, 0x49ed8eabcccc485e }, { 0xa81f301449ee8c70, 0x5c68f256bfff5a75 },
+    { 0xd226fc195c6a2f8c, 0x73832eec6fff3112 }, { 0x83585d8fd9c25db7, 0xc831fd53c5ff7eac },
+    { 0xa42e74f3d032f525, 0xba3e7ca8b77f5e56 }, { 0xcd3a1230c43fb26f, 0x28ce1bd2e55f35ec },
+    { 0x80444b5e7aa7cf85, 0x7980d163cf5b81b4 }, { 0xa0555e361951c366, 0xd7e105bcc3326220 },
+    { 0xc86ab5c39fa63440, 0x8dd9472bf3fefaa8 }, { 0xfa856334878fc150, 0xb14f98f6f0feb952 },
+    { 0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d4 }, { 0xc3b8358109e84f07, 0x0a862f80ec4700c9 },
+    { 0xf4a642e14c6262c8, 0xcd27bb612758c0fb }, { 0x98e7e9cccfbd7dbd, 0x8038d51cb897789d },
+    { 0xbf21e44003acdd2c, 0xe0470a63e6bd56c4 }, { 0xeeea5d5004981478, 0x1858ccfce06cac75 },
+    { 0x95527a5202df0ccb, 0x0f37801e0c43ebc9 }, { 0xbaa718e68396cffd, 0xd30560258f54e6bb },
+    { 0xe950df20247c83fd, 0x47c6b82ef32a206a }, { 0x91d28b7416cdd27e, 0x4cdc331d57fa5442 },
+    { 0xb6472e511c81471d, 0xe0133fe4adf8e953 }, { 0xe3d8f9e563a198e5, 0x58180fddd97723a7 },
+    { 0x8e679c2f5e44ff8f, 0x570f09eaa7ea7649 }, { 0xb201833b35d63f73, 0x2cd2cc6551e513db },
+    { 0xde81e40a034bcf4f, 0xf8077f7ea65e58d2 }, { 0x8b112e86420f6191, 0xfb04afaf27faf783 },
+    { 0xadd57a27d29339f6, 0x79c5db9af1f9b564 }, { 0xd94ad8b1c7380874, 0x18375281ae7822bd },
+    { 0x87cec76f1c830548, 0x8f2293910d0b15b6 }, { 0xa9c2794ae3a3c69a, 0xb2eb3875504ddb23 },
+    { 0xd433179d9c8cb841, 0x5fa60692a46151ec }, { 0x849feec281d7f328, 0xdbc7c41ba6bcd334 },
+    { 0xa5c7ea73224deff3, 0x12b9b522906c0801 }, { 0xcf39e50feae16bef, 0xd768226b34870a01 },
+    { 0x81842f29f2cce375, 0xe6a1158300d46641 }, { 0xa1e53af46f801c53, 0x60495ae3c1097fd1 },
+    { 0xca5e89b18b602368, 0x385bb19cb14bdfc5 }, { 0xfcf62c1dee382c42, 0x46729e03dd9ed7b6 },
+    { 0x9e19db92b4e31ba9, 0x6c07a2c26a8346d2 },
+};
+
+/*
+ * Multiply two 64-bit numbers into 128 bits.
+ * Returns the high 64 bits, and sets *low to the low 64 bits.
+ */
+static uint64_t str__mul_128 (uint64_t a, uint64_t b, uint64_t * low) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *low = (uint64_t)product;
+    return (uint64_t)(product >> 64);
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t middle = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *low = (middle << 32) | (uint32_t)lo_lo;
+    return hi_hi + (hi_lo >> 32) + (middle >> 32);
+#endif
+}
+
+/*
+ * The high 64 bits of g * cp / 2^64, with the lowest bit set if any of the
+ * dropped bits were, so that it still tells exact results from inexact ones.
+ */
+static uint64_t str__round_to_odd (const uint64_t g[2], uint64_t cp) {
+    uint64_t x_lo, y_lo;
+    uint64_t x_hi = str__mul_128(g[1], cp, &x_lo);
+    uint64_t y_hi = str__mul_128(g[0], cp, &y_lo);
+    y_lo += x_hi;
+    y_hi += (y_lo < x_hi);
+    return y_hi | (y_lo > 1);
+}
+
+/*
+ * Generate the shortest digits that read back as the given positive, finite
+ * value, using Giulietti's Schubfach algorithm, which only needs 128-bit
+ * products with a table of powers of ten.
+ * The value is 0.d1d2d3... * 10^(*point).
+ * Returns the number of digits written.
+ */
+static int str__shortest_digits (double value, char digits[17], int * point) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t c = bits & ((1ull << 52) - 1);
+    int biased_e = (int)((bits >> 52) & 0x7ff);
+    int q;
+    if (biased_e == 0) {
+        q = -1074;
+    } else {
+        c |= 1ull << 52;
+        q = biased_e - 1075;
+    }
+    // Boundaries that round to the value also read back as it when c is even
+    bool even = (c & 1) == 0;
+    // At a power of two the gap to the next lower value is half as big
+    bool unequal_gaps = (c == (1ull << 52)) && biased_e > 1;
+
+    // The value and its rounding boundaries, times 4
+    uint64_t cbl = 4 * c - 2 + unequal_gaps;
+    uint64_t cb = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+
+    // k = floor(log10(2^q)), or floor(log10(3/4 2^q)) with unequal gaps,
+    // and h is the shift that lines them up with the table entry for 10^-k
+    int k = (q * 1262611 - (unequal_gaps ? 524031 : 0)) >> 22;
+    int h = q + ((-k * 1741647) >> 19) + 1;
+    const uint64_t * g = str__pow10_table[-k + 292];
+    uint64_t vbl = str__round_to_odd(g, cbl << h);
+    uint64_t vb = str__round_to_odd(g, cb << h);
+    uint64_t vbr = str__round_to_odd(g, cbr << h);
+    uint64_t lower = vbl + !even;
+    uint64_t upper = vbr - !even;
+
+    // Try one digit fewer than 10^k gives, and then the two closest
+    uint64_t m = vb / 4;
+    bool done = false;
+    if (m >= 10) {
+        uint64_t shorter = m / 10;
+        bool down_inside = lower <= 40 * shorter;
+        bool up_inside = 40 * shorter + 40 <= upper;
+        if (down_inside != up_inside) {
+            m = shorter + up_inside;
+            k++;
+            done = true;
+        }
+    }
+    if (!done) {
+        bool down_inside = lower <= 4 * m;
+        bool up_inside = 4 * m + 4 <= upper;
+        if (down_inside == up_inside) {
+            // Both are in range, so round to the nearest, ties to even
+            uint64_t mid = 4 * m + 2;
+            up_inside = vb > mid || (vb == mid && (m & 1) != 0);
+        }
+        m += up_inside;
+    }
+
+    while (m % 10 == 0) {
+        m /= 10;
+        k++;
+    }
+    char buf[20];
+    char * start = str__format_u64(buf + sizeof(buf), m);
+    int n = (int)(buf + sizeof(buf) - start);
+    memcpy(digits, start, n);
+    *point = k + n;
+    return n;
+}
+
+/*
+ * Append the shortest decimal form of a double that reads back as the same
+ * value to a String.
+ * Uses plain notation for values from 1e-6 up to 1e21, like
+ * 0.001 and 12.5, and exponent notation otherwise, like 1e+21 and 5e-324.
+ * Reallocates the string.
+ * Returns the string pointer.
+ */
+INH_string * str_append_double (INH_string * string, double value) {
+    char buf[32];
+    size_t len = 0;
+    if (value != value) {
+        return str__append_chars(string, "nan", 3);
+    }
+    if (signbit(value)) {
+        buf[len++] = '-';
+        value = -value;
+    }
+    if (value == INFINITY) {
+        memcpy(buf + len, "inf", 3);
+        return str__append_chars(string, buf, len + 3);
+    }
+    if (value < 9007199254740992.0 && value == (double)(uint64_t)value) {
+        // Integers below 2^53 are exact, so their plain digits are shortest
+        char * start = str__format_u64(buf + sizeof(buf), (uint64_t)value);
+        size_t digits_len = buf + sizeof(buf) - start;
+        memmove(buf + len, start, digits_len);
+        return str__append_chars(string, buf, len + digits_len);
+    }
+
+    char digits[17];
+    int point;
+    int n = str__shortest_digits(value, digits, &point);
+    int i;
+    if (n <= point && point <= 21) {
+        memcpy(buf + len, digits, n);
+        len += n;
+        for (i = n; i < point; i++) {
+            buf[len++] = '0';
+        }
+    } else if (0 < point && point <= 21) {
+        memcpy(buf + len, digits, point);
+        len += point;
+        buf[len++] = '.';
+        memcpy(buf + len, digits + point, n - point);
+        len += n - point;
+    } else if (-6 < point && point <= 0) {
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for (i = point; i < 0; i++) {
+            buf[len++] = '0';
+        }
+        memcpy(buf + len, digits, n);
+        len += n;
+    } else {
+        buf[len++] = digits[0];
+        if (n > 1) {
+            buf[len++] = '.';
+            memcpy(buf + len, digits + 1, n - 1);
+            len += n - 1;
+        }
+        int exponent = point - 1;
+        buf[len++] = 'e';
+        buf[len++] = (exponent < 0) ? '-' : '+';
+        char * end = buf + len + 3;
+        char * start = str__format_u64(end, (exponent < 0) ? -exponent : exponent);
+        memmove(buf + len, start, end - start);
+        len += end - start;
+    }
+    return str__append_chars(string, buf, len);
+}
+
+/*
+ * Parse an unsigned decimal integer from the start of a view.
+ * Returns the number of characters parsed, or 0 if there is no number or it
+ * does not fit in 64 bits.
+ */
+size_t str_parse_u64 (INH_view view, uint64_t * value) {
+    uint64_t result = 0;
+    size_t i;
+    for (i = 0; i < view.len; i++) {
+        unsigned digit = (unsigned char)view.data[i] - '0';
+        if (digit > 9) {
+            break;
+        }
+        if (result > (UINT64_MAX - digit) / 10) {
+            // Overflow
+            return 0;
+        }
+        result = result * 10 + digit;
+    }
+    if (i == 0) {
+        return 0;
+    }
+    *value = result;
+    return i;
+}
+
+/*
+ * Parse a signed decimal integer, with an optional + or - sign, from the
+ * start of a view.
+ * Returns the number of characters parsed, or 0 if there is no number or it
+ * does not fit in 64 bits.
+ */
+size_t str_parse_int (INH_view view, int64_t * value) {
+    bool negative = false;
+    size_t sign_len = 0;
+    if (view.len > 0 && (view.data[0] == '-' || view.data[0] == '+')) {
+        negative = (view.data[0] == '-');
+        sign_len = 1;
+    }
+    INH_view digits = { view.data + sign_len, view.len - sign_len };
+    uint64_t magnitude;
+    size_t len = str_parse_u64(digits, &magnitude);
+    if (len == 0) {
+        return 0;
+    }
+    if (magnitude > (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX)) {
+        // Overflow
+        return 0;
+    }
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return sign_len + len;
+}
+
+/*
+ * Returns if the view starts with the lowercase word, ignoring case.
+ */
+static bool str__starts_with_nocase (INH_view view, const char * word) {
+    size_t i;
+    for (i = 0; word[i] != '\0'; i++) {
+        if (i >= view.len || (view.data[i] | 0x20) != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Parse a decimal floating point number, like -12.5e3, inf or nan, from the
+ * start of a view.
+ * Numbers with at most 19 significant digits whose value is exactly
+ * computable in a double are parsed directly. Other numbers go through
+ * strtod, which expects the "C" locale.
+ * Returns the number of characters parsed, or 0 if there is no number.
+ */
+size_t str_parse_double (INH_view view, double * value) {
+    static const double pow10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    const char * data = view.data;
+    size_t len = view.len;
+    size_t i = 0;
+    bool negative = false;
+    if (i < len && (data[i] == '-' || data[i] == '+')) {
+        negative = (data[i] == '-');
+        i++;
+    }
+
+    INH_view rest = { data + i, len - i };
+    if (str__starts_with_nocase(rest, "nan")) {
+        *value = NAN;
+        return i + 3;
+    }
+    if (str__starts_with_nocase(rest, "inf")) {
+        *value = negative ? -INFINITY : INFINITY;
+        return i + (str__starts_with_nocase(rest, "infinity") ? 8 : 3);
+    }
+
+    uint64_t mantissa = 0;
+    int mantissa_digits = 0;
+    int exponent = 0;
+    bool exact = true;
+    bool any_digits = false;
+    for (; i < len && (unsigned)(data[i] - '0') <= 9; i++) {
+        any_digits = true;
+        if (mantissa_digits < 19) {
+            mantissa = mantissa * 10 + (data[i] - '0');
+            mantissa_digits += (mantissa != 0);
+        } else {
+            exact = false;
+            exponent++;
+        }
+    }
+    if (i < len && data[i] == '.') {
+        size_t dot = i++;
+        for (; i < len && (unsigned)(data[i] - '0') <= 9; i++) {
+            any_digits = true;
+            if (mantissa_digits < 19) {
+                mantissa = mantissa * 10 + (data[i] - '0');
+                mantissa_digits += (mantissa != 0);
+                exponent--;
+            } else {
+                exact = false;
+            }
+        }
+        if (!any_digits) {
+            // A lone dot is not a number
+            i = dot;
+        }
+    }
+    if (!any_digits) {
+        return 0;
+    }
+    if (i < len && (data[i] | 0x20) == 'e') {
+        size_t j = i + 1;
+        bool exponent_negative = false;
+        if (j < len && (data[j] == '-' || data[j] == '+')) {
+            exponent_negative = (data[j] == '-');
+            j++;
+        }
+        if (j < len && (unsigned)(data[j] - '0') <= 9) {
+            int written = 0;
+            for (; j < len && (unsigned)(data[j] - '0') <= 9; j++) {
+                if (written < 100000) {
+                    written = written * 10 + (data[j] - '0');
+                }
+            }
+            exponent += exponent_negative ? -written : written;
+            i = j;
+        }
+    }
+
+    double result;
+    if (mantissa == 0 && exact) {
+        result = 0.0;
+    } else if (exact && mantissa <= (1ull << 53) && -22 <= exponent && exponent <= 22) {
+        // Both operands are exact, so one rounding gives the correct result
+        result = (double)mantissa;
+        result = (exponent < 0) ? result / pow10[-exponent] : result * pow10[exponent];
+    } else {
+        char small[64];
+        char * copy = (i < sizeof(small)) ? small : malloc(i + 1);
+        if (copy == NULL) {
+            // Malloc failed
+            return 0;
+        }
+        memcpy(copy, data, i);
+        copy[i] = '\0';
+        result = strtod(copy, NULL);
+        if (copy != small) {
+            free(copy);
+        }
+        *value = result;
+        return i;
+    }
+    *value = negative ? -result : result;
+    return i;
+}
+
+/*
+ * Initialize an empty String list.
+ */
+void str_list_init (INH_string_list * list) {
+    list->parts = NULL;
+    list->count = 0;
+    list->capacity = 0;
+    list->total_len = 0;
+    list->total_known = true;
+}
+
+/*
+ * Free the memory used by a String list, but not the text it refers to.
+ */
+void str_list_free (INH_string_list * list) {
+    free(list->parts);
+    str_list_init(list);
+}
+
+/*
+ * Add a view to the end of a String list, without copying its text.
+ * Returns false if the list could not grow.
+ */
+bool str_list_add_view (INH_string_list * list, INH_view view) {
+    if (list->count == list->capacity) {
+        size_t new_capacity = list->capacity ? list->capacity * 2 : 8;
+        INH_view * new_parts = realloc(list->parts, new_capacity * sizeof(*new_parts));
+        if (new_parts == NULL) {
+            // Realloc failed
+            return false;
+        }
+        list->parts = new_parts;
+        list->capacity = new_capacity;
+    }
+    list->parts[list->count++] = view;
+    list->total_known = false;
+    return true;
+}
+
+/*
+ * Add a String to the end of a String list, without copying it.
+ * Returns false if the list could not grow.
+ */
+bool str_list_add (INH_string_list * list, const INH_string * string) {
+    return str_list_add_view(list, str_view(string));
+}
+
+/*
+ * Returns the total length of the text in a String list.
+ * It is only summed up again after parts are added.
+ */
+size_t str_list_len (INH_string_list * list) {
+    if (!list->total_known) {
+        size_t total = 0;
+        size_t i;
+        for (i = 0; i < list->count; i++) {
+            total += list->parts[i].len;
+        }
+        list->total_len = total;
+        list->total_known = true;
+    }
+    return list->total_len;
+}
+
+/*
+ * Write the text of a String list to a character stream, which must have
+ * room for str_list_len characters.
+ *
+ * Returns the number of characters written
+ */
+size_t str_list_write_stream (const INH_string_list * list, char * stream) {
+    size_t written = 0;
+    size_t i;
+    for (i = 0; i < list->count; i++) {
+        memcpy(stream + written, list->parts[i].data, list->parts[i].len);
+        written += list->parts[i].len;
+    }
+    return written;
+}
+
+/*
+ * Copy the text of a String list into one new String.
+ */
+INH_string * str_list_flatten (INH_string_list * list) {
+    INH_string * new = str_alloc(str_list_len(list));
+    if (new == NULL) {
+        return new;
+    }
+    str_list_write_stream(list, new->buffer);
+    return new;
+}
+
+/*
+ * Write the text of a String list to a stream.
+ *
+ * Returns:
+ * On success, returns a non-negative value
+ * On failure, returns EOF and sets the error indicator (see ferror()) on stream.
+ */
+int str_list_fwrite (const INH_string_list * list, FILE * stream) {
+    size_t i;
+    for (i = 0; i < list->count; i++) {
+        const INH_view * part = &list->parts[i];
+        if (fwrite(part->data, 1, part->len, stream) != part->len) {
+            // Failure
+            return EOF;
+        }
+    }
+    // Success
+    return 1;
+}
+
+#ifdef INH_STRING__POSIX
+/*
+ * Write the text of a String list to a file descriptor with writev, without
+ * copying it. Keeps writing after partial writes and interruptions.
+ *
+ * Returns the number of bytes written, or -1 and sets errno on failure.
+ */
+ssize_t str_list_writev (const INH_string_list * list, int fd) {
+#ifdef IOV_MAX
+    enum { batch_max = (IOV_MAX < 64) ? IOV_MAX : 64 };
+#else
+    enum { batch_max = 16 };
+#endif
+    struct iovec batch[batch_max];
+    size_t part = 0;
+    size_t offset = 0; // Bytes of the current part already written
+    ssize_t total = 0;
+    while (part < list->count) {
+        int n = 0;
+        size_t i;
+        for (i = part; i < list->count && n < batch_max; i++) {
+            size_t skip = (i == part) ? offset : 0;
+            batch[n].iov_base = (void *)(list->parts[i].data + skip);
+            batch[n].iov_len = list->parts[i].len - skip;
+            n++;
+        }
+        ssize_t result = writev(fd, batch, n);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        total += result;
+
+        // Advance past the parts that were completely written
+        size_t left = (size_t)result;
+        while (part < list->count && left >= list->parts[part].len - offset) {
+            left -= list->parts[part].len - offset;
+            offset = 0;
+            part++;
+        }
+        offset += left;
+    }
+    return total;
+}
+#endif
+
+/*
+ * Read up to max bytes from a FILE *, or from fd when file is NULL.
+ * Returns the number of bytes read.
+ */
+static size_t str__source_read (FILE * file, int fd, char * dest, size_t max, bool * eof, bool * error) {
+    if (file != NULL) {
+        size_t n = fread(dest, 1, max, file);
+        if (n < max) {
+            *error = ferror(file) != 0;
+            *eof = !*error;
+        }
+        return n;
+    }
+#ifdef INH_STRING__POSIX
+    for (;;) {
+        ssize_t n = read(fd, dest, max);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            *error = true;
+            return 0;
+        }
+        *eof = (n == 0);
+        return (size_t)n;
+    }
+#else
+    (void)fd;
+    *error = true;
+    return 0;
+#endif
+}
+
+static bool str__reader_init (INH_string_reader * reader, FILE * file, int fd, char delim, size_t block_size) {
+    if (block_size == 0) {
+        block_size = 64 * 1024;
+    }
+    reader->file = file;
+    reader->fd = fd;
+    reader->delim = delim;
+    reader->block_size = block_size;
+    // Room for a block, and the part of a record left over from the last one
+    reader->capacity = 2 * block_size;
+    reader->buffer = malloc(reader->capacity);
+    reader->start = 0;
+    reader->end = 0;
+    reader->scanned = 0;
+    reader->eof = false;
+    reader->error = false;
+#ifdef INH_STRING_THREADS
+    reader->ahead = NULL;
+#endif
+    return reader->buffer != NULL;
+}
+
+/*
+ * Initialize a reader for the records in a FILE *, which are separated by
+ * delim. The file is read block_size bytes at a time (0 for a default size).
+ * Returns false if the buffer could not be allocated.
+ */
+bool str_reader_init (INH_string_reader * reader, FILE * file, char delim, size_t block_size) {
+    return str__reader_init(reader, file, -1, delim, block_size);
+}
+
+#ifdef INH_STRING__POSIX
+/*
+ * Like str_reader_init, but reads from a file descriptor.
+ * See: str_reader_init
+ */
+bool str_reader_init_fd (INH_string_reader * reader, int fd, char delim, size_t block_size) {
+    return str__reader_init(reader, NULL, fd, delim, block_size);
+}
+#endif
+
+#ifdef INH_STRING_THREADS
+/*
+ * State shared with the thread that reads the next block while the current
+ * one is being split into records.
+ * The thread reads into buffer just after the first block_size bytes, which
+ * are left for the end of the current buffer.
+ */
+struct str__read_ahead {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    FILE * file;
+    int fd;
+    size_t block_size;
+    char * buffer;
+    size_t capacity;
+    size_t len; // Bytes read into buffer + block_size
+    bool requested;
+    bool done;
+    bool stop;
+    bool eof;
+    bool error;
+};
+
+static void * str__read_ahead_main (void * arg) {
+    struct str__read_ahead * ahead = arg;
+    pthread_mutex_lock(&ahead->lock);
+    for (;;) {
+        while (!ahead->requested && !ahead->stop) {
+            pthread_cond_wait(&ahead->cond, &ahead->lock);
+        }
+        if (ahead->stop) {
+            break;
+        }
+        ahead->requested = false;
+        pthread_mutex_unlock(&ahead->lock);
+
+        bool eof = false, error = false;
+        size_t len = str__source_read(ahead->file, ahead->fd, ahead->buffer + ahead->block_size,
+                ahead->block_size, &eof, &error);
+
+        pthread_mutex_lock(&ahead->lock);
+        ahead->len = len;
+        ahead->eof = eof;
+        ahead->error = error;
+        ahead->done = true;
+        pthread_cond_broadcast(&ahead->cond);
+    }
+    pthread_mutex_unlock(&ahead->lock);
+    return NULL;
+}
+
+/*
+ * Start reading the next block on a background thread while records are
+ * being split from the current one.
+ * This is only for regular files: a read from a pipe or socket can block
+ * until more input arrives, and str_reader_free would wait for it.
+ * Returns false if the source is not a regular file or the thread could not
+ * be started, and then the reader keeps reading on the calling thread.
+ */
+bool str_reader_start_read_ahead (INH_string_reader * reader) {
+    if (reader->ahead != NULL || reader->eof || reader->error) {
+        return reader->ahead != NULL;
+    }
+#ifdef INH_STRING__POSIX
+    struct stat info;
+    int fd = (reader->file != NULL) ? fileno(reader->file) : reader->fd;
+    if (fd < 0 || fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+#endif
+    struct str__read_ahead * ahead = malloc(sizeof(*ahead));
+    if (ahead == NULL) {
+        return false;
+    }
+    ahead->file = reader->file;
+    ahead->fd = reader->fd;
+    ahead->block_size = reader->block_size;
+    ahead->capacity = 2 * reader->block_size;
+    ahead->buffer = malloc(ahead->capacity);
+    ahead->len = 0;
+    ahead->requested = true;
+    ahead->done = false;
+    ahead->stop = false;
+    ahead->eof = false;
+    ahead->error = false;
+    if (ahead->buffer == NULL) {
+        free(ahead);
+        return false;
+    }
+    pthread_mutex_init(&ahead->lock, NULL);
+    pthread_cond_init(&ahead->cond, NULL);
+    if (pthread_create(&ahead->thread, NULL, str__read_ahead_main, ahead) != 0) {
+        pthread_mutex_destroy(&ahead->lock);
+        pthread_cond_destroy(&ahead->cond);
+        free(ahead->buffer);
+        free(ahead);
+        return false;
+    }
+    reader->ahead = ahead;
+    return true;
+}
+
+/*
+ * Take the block read by the background thread, and ask for the next one.
+ */
+static void str__reader_refill_ahead (INH_string_reader * reader) {
+    struct str__read_ahead * ahead = reader->ahead;
+    pthread_mutex_lock(&ahead->lock);
+    while (!ahead->done) {
+        pthread_cond_wait(&ahead->cond, &ahead->lock);
+    }
+    ahead->done = false;
+    pthread_mutex_unlock(&ahead->lock);
+
+    size_t block_size = reader->block_size;
+    size_t left = reader->end - reader->start;
+    char * fresh = ahead->buffer + block_size;
+    if (left <= block_size) {
+        // Put the leftover just before the new block and swap buffers
+        char * old_buffer = reader->buffer;
+        size_t old_capacity = reader->capacity;
+        memcpy(fresh - left, reader->buffer + reader->start, left);
+        reader->buffer = ahead->buffer;
+        reader->capacity = ahead->capacity;
+        reader->start = block_size - left;
+        reader->end = block_size + ahead->len;
+        ahead->buffer = old_buffer;
+        ahead->capacity = old_capacity;
+    } else {
+        // A record longer than a block is gathered in the current buffer
+        memmove(reader->buffer, reader->buffer + reader->start, left);
+        reader->start = 0;
+        reader->end = left;
+        if (reader->capacity < left + ahead->len) {
+            size_t new_capacity = 2 * reader->capacity;
+            char * new_buffer = realloc(reader->buffer, new_capacity);
+            if (new_buffer == NULL) {
+                // Realloc failed
+                reader->error = true;
+                return;
+            }
+            reader->buffer = new_buffer;
+            reader->capacity = new_capacity;
+        }
+        memcpy(reader->buffer + reader->end, fresh, ahead->len);
+        reader->end += ahead->len;
+    }
+    reader->eof = ahead->eof;
+    reader->error = ahead->error;
+
+    if (!reader->eof && !reader->error) {
+        pthread_mutex_lock(&ahead->lock);
+        ahead->requested = true;
+        pthread_cond_broadcast(&ahead->cond);
+        pthread_mutex_unlock(&ahead->lock);
+    }
+}
+#endif
+
+/*
+ * Make room in the buffer and read more data into it.
+ */
+static void str__reader_refill (INH_string_reader * reader) {
+#ifdef INH_STRING_THREADS
+    if (reader->ahead != NULL) {
+        str__reader_refill_ahead(reader);
+        return;
+    }
+#endif
+    // Compact: move the unfinished record to the front of the buffer
+    size_t left = reader->end - reader->start;
+    if (reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, left);
+        reader->start = 0;
+        reader->end = left;
+    }
+    if (reader->end == reader->capacity) {
+        // The record is longer than the buffer
+        size_t new_capacity = 2 * reader->capacity;
+        char * new_buffer = realloc(reader->buffer, new_capacity);
+        if (new_buffer == NULL) {
+            // Realloc failed
+            reader->error = true;
+            return;
+        }
+        reader->buffer = new_buffer;
+        reader->capacity = new_capacity;
+    }
+    reader->end += str__source_read(reader->file, reader->fd, reader->buffer + reader->end,
+            reader->capacity - reader->end, &reader->eof, &reader->error);
+}
+
+/*
+ * Get the next record, without its delimiter, as a view into the reader's
+ * buffer. The view is valid until the next call with this reader.
+ * The last record does not need a delimiter after it.
+ * Returns false when there are no more records, or there was an error (see
+ * str_reader_error).
+ */
+bool str_reader_next (INH_string_reader * reader, INH_view * record) {
+    for (;;) {
+        char * base = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        char * found = memchr(base + reader->scanned, reader->delim, available - reader->scanned);
+        if (found != NULL) {
+            record->data = base;
+            record->len = found - base;
+            reader->start += record->len + 1;
+            reader->scanned = 0;
+            return true;
+        }
+        // Don't search this data again after refilling
+        reader->scanned = available;
+
+        if (reader->error) {
+            // Leave the unfinished record unread
+            return false;
+        }
+        if (reader->eof) {
+            if (available == 0) {
+                return false;
+            }
+            record->data = base;
+            record->len = available;
+            reader->start = reader->end;
+            reader->scanned = 0;
+            return true;
+        }
+        str__reader_refill(reader);
+    }
+}
+
+/*
+ * Returns if the reader failed to read or allocate memory.
+ */
+bool str_reader_error (const INH_string_reader * reader) {
+    return reader->error;
+}
+
+/*
+ * Free a reader's buffers and stop its read-ahead thread.
+ * The FILE * or file descriptor is not closed.
+ */
+void str_reader_free (INH_string_reader * reader) {
+#ifdef INH_STRING_THREADS
+    struct str__read_ahead * ahead = reader->ahead;
+    if (ahead != NULL) {
+        pthread_mutex_lock(&ahead->lock);
+        ahead->stop = true;
+        pthread_cond_broadcast(&ahead->cond);
+        pthread_mutex_unlock(&ahead->lock);
+        pthread_join(ahead->thread, NULL);
+        pthread_mutex_destroy(&ahead->lock);
+        pthread_cond_destroy(&ahead->cond);
+        free(ahead->buffer);
+        free(ahead);
+        reader->ahead = NULL;
+    }
+#endif
+    free(reader->buffer);
+    reader->buffer = NULL;
+}
+
+/*
+ * Sorting works on entries that cache 8 bytes of each string, so most
+ * comparisons don't have to follow the string pointers.
+ */
+typedef struct str__sort_entry {
+    uint64_t key; // Bytes depth...depth+8 of the string, big-endian, padded with 0
+    INH_string * string;
+} str__sort_entry;
+
+static uint64_t str__sort_key (const INH_string * string, size_t depth) {
+    const unsigned char * p = (const unsigned char *)string->buffer + depth;
+    if (string->len >= depth + 8) {
+        return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+            ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+            ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+    }
+    uint64_t key = 0;
+    size_t i;
+    for (i = 0; depth + i < string->len; i++) {
+        key |= (uint64_t)p[i] << (56 - 8 * i);
+    }
+    return key;
+}
+
+static int str__sort_entry_compare (const str__sort_entry * a, const str__sort_entry * b, size_t depth) {
+    if (a->key != b->key) {
+        return (a->key < b->key) ? -1 : 1;
+    }
+    // The strings are equal up to depth + 8, or up to the end of the shorter one
+    size_t min_len = (a->string->len < b->string->len) ? a->string->len : b->string->len;
+    return str__compare_from(a->string, b->string, (depth + 8 < min_len) ? depth + 8 : min_len);
+}
+
+static void str__sort_insertion (str__sort_entry * entries, size_t len, size_t depth) {
+    size_t i, j;
+    for (i = 1; i < len; i++) {
+        str__sort_entry entry = entries[i];
+        for (j = i; j > 0 && str__sort_entry_compare(&entry, &entries[j - 1], depth) < 0; j--) {
+            entries[j] = entries[j - 1];
+        }
+        entries[j] = entry;
+    }
+}
+
+static int str__sort_len_compare (const void * a, const void * b) {
+    size_t len1 = ((const str__sort_entry *)a)->string->len;
+    size_t len2 = ((const str__sort_entry *)b)->string->len;
+    return (len1 > len2) - (len1 < len2);
+}
+
+static uint64_t str__sort_median (uint64_t a, uint64_t b, uint64_t c) {
+    return (a < b) ? ((b < c) ? b : ((a < c) ? c : a)) : ((a < c) ? a : ((b < c) ? c : b));
+}
+
+/*
+ * Multikey quicksort: three-way partition on the cached 8 bytes, then sort
+ * the equal part on the next 8 bytes.
+ * All the entries must be equal before depth, and have keys for depth.
+ */
+static void str__sort_range (str__sort_entry * entries, size_t len, size_t depth) {
+    while (len > 1) {
+        if (len < 16) {
+            str__sort_insertion(entries, len, depth);
+            return;
+        }
+
+        // Median of three pivot, or for bigger ranges the median of three
+        // medians (Tukey's ninther), which holds up on sorted and reversed runs
+        uint64_t pivot;
+        size_t m = len / 2;
+        if (len < 64) {
+            pivot = str__sort_median(entries[0].key, entries[m].key, entries[len - 1].key);
+        } else {
+            size_t s = len / 8;
+            pivot = str__sort_median(
+                str__sort_median(entries[0].key, entries[s].key, entries[2 * s].key),
+                str__sort_median(entries[m - s].key, entries[m].key, entries[m + s].key),
+                str__sort_median(entries[len - 1 - 2 * s].key, entries[len - 1 - s].key, entries[len - 1].key));
+        }
+
+        // entries[0...lt] < pivot, entries[lt...i] == pivot, entries[gt...len] > pivot
+        size_t lt = 0, i = 0, gt = len;
+        while (i < gt) {
+            if (entries[i].key < pivot) {
+                str__sort_entry t = entries[lt];
+                entries[lt++] = entries[i];
+                entries[i++] = t;
+            } else if (entries[i].key > pivot) {
+                str__sort_entry t = entries[--gt];
+                entries[gt] = entries[i];
+                entries[i] = t;
+            } else {
+                i++;
+            }
+        }
+
+        // Strings that end within the key are prefixes of the longer ones,
+        // so they go first, shortest first
+        str__sort_entry * equal = entries + lt;
+        size_t equal_len = gt - lt;
+        size_t done = 0;
+        for (i = 0; i < equal_len; i++) {
+            if (equal[i].string->len <= depth + 8) {
+                str__sort_entry t = equal[done];
+                equal[done++] = equal[i];
+                equal[i] = t;
+            }
+        }
+        if (done > 1) {
+            qsort(equal, done, sizeof(*equal), str__sort_len_compare);
+        }
+        equal += done;
+        equal_len -= done;
+        for (i = 0; i < equal_len; i++) {
+            equal[i].key = str__sort_key(equal[i].string, depth + 8);
+        }
+
+        // Recurse into the two smaller parts and loop on the biggest one,
+        // so the stack stays O(log len) deep
+        str__sort_entry * parts[3] = { entries, entries + gt, equal };
+        size_t lens[3] = { lt, len - gt, equal_len };
+        size_t depths[3] = { depth, depth, depth + 8 };
+        size_t big = (lens[0] >= lens[1]) ? 0 : 1;
+        if (lens[2] > lens[big]) {
+            big = 2;
+        }
+        for (i = 0; i < 3; i++) {
+            if (i != big) {
+                str__sort_range(parts[i], lens[i], depths[i]);
+            }
+        }
+        entries = parts[big];
+        len = lens[big];
+        depth = depths[big];
+    }
+}
+
+static int str__qsort_compare (const void * a, const void * b) {
+    return str_compare(*(INH_string * const *)a, *(INH_string * const *)b);
+}
+
+/*
+ * Sort an array of Strings in str_compare order.
+ * The sort is not stable.
+ */
+void str_sort (INH_string * strings[], size_t len) {
+    if (len < 2) {
+        return;
+    }
+    str__sort_entry * entries = malloc(len * sizeof(*entries));
+    if (entries == NULL) {
+        // Malloc failed, so sort without the cached keys
+        qsort(strings, len, sizeof(*strings), str__qsort_compare);
+        return;
+    }
+    size_t i;
+    for (i = 0; i < len; i++) {
+        entries[i].key = str__sort_key(strings[i], 0);
+        entries[i].string = strings[i];
+    }
+    str__sort_range(entries, len, 0);
+    for (i = 0; i < len; i++) {
+        strings[i] = entries[i].string;
+    }
+    free(entries);
+}
+
+#ifdef INH_STRING_THREADS
+/*
+ * Buckets of entries with the same first differing byte, shared by the
+ * sorting threads.
+ */
+struct str__sort_buckets {
+    str__sort_entry * entries;
+    size_t starts[257];
+    size_t next; // Next bucket to sort
+    pthread_mutex_t lock;
+};
+
+static void * str__sort_buckets_main (void * arg) {
+    struct str__sort_buckets * buckets = arg;
+    for (;;) {
+        pthread_mutex_lock(&buckets->lock);
+        size_t bucket = buckets->next++;
+        pthread_mutex_unlock(&buckets->lock);
+        if (bucket >= 256) {
+            return NULL;
+        }
+        size_t start = buckets->starts[bucket];
+        str__sort_range(buckets->entries + start, buckets->starts[bucket + 1] - start, 0);
+    }
+}
+
+/*
+ * Like str_sort, but uses up to the given number of threads.
+ * The Strings are first split into groups by their first byte that is not
+ * the same in all of them (within the first 8), and then the threads sort
+ * those groups. It works best when that byte varies a lot.
+ */
+void str_sort_parallel (INH_string * strings[], size_t len, int threads) {
+    if (threads > 256) {
+        threads = 256;
+    }
+    str__sort_entry * entries = NULL;
+    str__sort_entry * unsorted = NULL;
+    if (threads > 1 && len >= 4096) {
+        entries = malloc(len * sizeof(*entries));
+        unsorted = malloc(len * sizeof(*unsorted));
+    }
+    if (entries == NULL || unsorted == NULL) {
+        free(entries);
+        free(unsorted);
+        str_sort(strings, len);
+        return;
+    }
+
+    // Find the first byte where the keys differ
+    uint64_t differ = 0;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        unsorted[i].key = str__sort_key(strings[i], 0);
+        unsorted[i].string = strings[i];
+        differ |= unsorted[i].key ^ unsorted[0].key;
+    }
+    int shift = 56;
+    while (shift > 0 && ((differ >> shift) & 0xff) == 0) {
+        shift -= 8;
+    }
+
+    // Most significant byte radix pass on that byte
+    struct str__sort_buckets buckets;
+    size_t counts[256] = {0};
+    for (i = 0; i < len; i++) {
+        counts[(unsorted[i].key >> shift) & 0xff]++;
+    }
+    buckets.starts[0] = 0;
+    for (i = 0; i < 256; i++) {
+        buckets.starts[i + 1] = buckets.starts[i] + counts[i];
+        counts[i] = buckets.starts[i];
+    }
+    for (i = 0; i < len; i++) {
+        entries[counts[(unsorted[i].key >> shift) & 0xff]++] = unsorted[i];
+    }
+    free(unsorted);
+
+    buckets.entries = entries;
+    buckets.next = 0;
+    pthread_mutex_init(&buckets.lock, NULL);
+    pthread_t workers[256];
+    int started;
+    for (started = 0; started < threads - 1; started++) {
+        if (pthread_create(&workers[started], NULL, str__sort_buckets_main, &buckets) != 0) {
+            // Carry on with the threads that did start
+            break;
+        }
+    }
+    str__sort_buckets_main(&buckets);
+    int t;
+    for (t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    pthread_mutex_destroy(&buckets.lock);
+
+    for (i = 0; i < len; i++) {
+        strings[i] = entries[i].string;
+    }
+    free(entries);
+}
+#endif
+
+/*
+ * Initialize a String builder with room for capacity characters (0 for a
+ * default size).
+ * Returns false if the String could not be allocated.
+ */
+bool str_builder_init (INH_string_builder * builder, size_t capacity) {
+    builder->string = str_alloc(capacity ? capacity : 64);
+    builder->len = 0;
+    return builder->string != NULL;
+}
+
+/*
+ * Make sure that a String builder has room for extra more characters.
+ * Returns false if the String could not grow.
+ */
+bool str_builder_reserve (INH_string_builder * builder, size_t extra) {
+    size_t capacity = builder->string->len;
+    if (extra <= capacity - builder->len) {
+        return true;
+    }
+    size_t new_capacity = 2 * capacity;
+    if (new_capacity < builder->len + extra) {
+        new_capacity = builder->len + extra;
+    }
+    INH_string * new = realloc(builder->string, sizeof(*new) + new_capacity);
+    if (new == NULL) {
+        // Realloc failed
+        return false;
+    }
+    new->len = new_capacity;
+    builder->string = new;
+    return true;
+}
+
+static bool str__builder_append_chars (INH_string_builder * builder, const char * chars, size_t len) {
+    if (!str_builder_reserve(builder, len)) {
+        return false;
+    }
+    memcpy(builder->string->buffer + builder->len, chars, len);
+    builder->len += len;
+    return true;
+}
+
+/*
+ * Append a character to a String builder.
+ * Returns false if the String could not grow.
+ */
+bool str_builder_append_char (INH_string_builder * builder, char ch) {
+    if (!str_builder_reserve(builder, 1)) {
+        return false;
+    }
+    builder->string->buffer[builder->len++] = ch;
+    return true;
+}
+
+/*
+ * Append viewed characters to a String builder.
+ * Returns false if the String could not grow.
+ */
+bool str_builder_append_view (INH_string_builder * builder, INH_view view) {
+    return str__builder_append_chars(builder, view.data, view.len);
+}
+
+/*
+ * Append a String to a String builder.
+ * Returns false if the String could not grow.
+ */
+bool str_builder_append (INH_string_builder * builder, const INH_string * string) {
+    return str__builder_append_chars(builder, string->buffer, string->len);
+}
+
+/*
+ * Append printf-style formatted text to a String builder.
+ * The text is formatted straight into the spare room, and only formatted
+ * again if it did not fit.
+ * Returns false if formatting failed or the String could not grow.
+ */
+bool str_builder_printf (INH_string_builder * builder, const char * format, ...) {
+    va_list args;
+    size_t spare = builder->string->len - builder->len;
+    va_start(args, format);
+    int len = vsnprintf(builder->string->buffer + builder->len, spare, format, args);
+    va_end(args);
+    if (len < 0) {
+        return false;
+    }
+    if ((size_t)len >= spare) {
+        // Room for the text and the null character vsnprintf always writes
+        if (!str_builder_reserve(builder, (size_t)len + 1)) {
+            return false;
+        }
+        va_start(args, format);
+        vsnprintf(builder->string->buffer + builder->len, (size_t)len + 1, format, args);
+        va_end(args);
+    }
+    builder->len += len;
+    return true;
+}
+
+/*
+ * Returns the index of the first character that must be escaped in a JSON
+ * string: a quote, backslash or control character. Returns len if there is
+ * none.
+ */
+static size_t str__json_scan (const char * p, size_t len) {
+    size_t i = 0;
+#ifdef INH_STRING__SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control_max = _mm_set1_epi8(0x1f);
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash));
+        // x <= 0x1f, as unsigned bytes
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(x, control_max), x));
+        if (_mm_movemask_epi8(special)) {
+            break;
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        unsigned char c = p[i];
+        if (c == '"' || c == '\\' || c < 0x20) {
+            break;
+        }
+    }
+    return i;
+}
+
+/*
+ * Append viewed characters to a String builder as a quoted JSON string.
+ * Runs of characters that need no escaping are copied at once.
+ * Returns false if the String could not grow.
+ */
+bool str_builder_append_json (INH_string_builder * builder, INH_view view) {
+    static const char hex[] = "0123456789abcdef";
+    if (!str_builder_append_char(builder, '"')) {
+        return false;
+    }
+    size_t i = 0;
+    while (i < view.len) {
+        size_t run = str__json_scan(view.data + i, view.len - i);
+        // Room for the run and one escape
+        if (!str_builder_reserve(builder, run + 6)) {
+            return false;
+        }
+        char * out = builder->string->buffer + builder->len;
+        memcpy(out, view.data + i, run);
+        out += run;
+        i += run;
+        if (i < view.len) {
+            unsigned char c = view.data[i++];
+            *out++ = '\\';
+            switch (c) {
+                case '"': *out++ = '"'; break;
+                case '\\': *out++ = '\\'; break;
+                case '\b': *out++ = 'b'; break;
+                case '\f': *out++ = 'f'; break;
+                case '\n': *out++ = 'n'; break;
+                case '\r': *out++ = 'r'; break;
+                case '\t': *out++ = 't'; break;
+                default:
+                    *out++ = 'u';
+                    *out++ = '0';
+                    *out++ = '0';
+                    *out++ = hex[c >> 4];
+                    *out++ = hex[c & 0xf];
+                    break;
+            }
+        }
+        builder->len = out - builder->string->buffer;
+    }
+    return str_builder_append_char(builder, '"');
+}
+
+/*
+ * Returns if a CSV field must be quoted, because it has a separator, quote,
+ * or line break in it.
+ */
+static bool str__csv_needs_quotes (const char * p, size_t len, char sep) {
+    size_t i = 0;
+#ifdef INH_STRING__SSE2
+    const __m128i sep_v = _mm_set1_epi8(sep);
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(x, sep_v), _mm_cmpeq_epi8(x, quote));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi8(x, cr), _mm_cmpeq_epi8(x, lf)));
+        if (_mm_movemask_epi8(special)) {
+            return true;
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        char c = p[i];
+        if (c == sep || c == '"' || c == '\r' || c == '\n') {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Append viewed characters to a String builder as a CSV field (RFC 4180).
+ * The field is only quoted if it needs to be, and quotes in it are doubled.
+ * Returns false if the String could not grow.
+ */
+bool str_builder_append_csv (INH_string_builder * builder, INH_view view, char sep) {
+    if (!str__csv_needs_quotes(view.data, view.len, sep)) {
+        return str_builder_append_view(builder, view);
+    }
+    if (!str_builder_append_char(builder, '"')) {
+        return false;
+    }
+    const char * p = view.data;
+    const char * end = view.data + view.len;
+    while (p < end) {
+        const char * quote = memchr(p, '"', end - p);
+        // Copy up to and including the quote, and then double it
+        const char * run_end = quote ? quote + 1 : end;
+        if (!str__builder_append_chars(builder, p, run_end - p)) {
+            return false;
+        }
+        if (quote && !str_builder_append_char(builder, '"')) {
+            return false;
+        }
+        p = run_end;
+    }
+    return str_builder_append_char(builder, '"');
+}
+
+/*
+ * Get the built String, without its spare room.
+ * The builder must be initialized again before it is used again.
+ */
+INH_string * str_builder_finish (INH_string_builder * builder) {
+    INH_string * result = str_realloc(builder->string, builder->len);
+    builder->string = NULL;
+    builder->len = 0;
+    return result;
+}
+
+/*
+ * Free a String builder that was not finished.
+ */
+void str_builder_free (INH_string_builder * builder) {
+    free(builder->string);
+    builder->string = NULL;
+    builder->len = 0;
+}
+
+/*
+ * A packed String is laid out as:
+ *   length (1, 2, 4 or 8 bytes), flags (1 byte), text, optional null character
+ * and an INH_packed_string * points at the flags byte.
+ * The low 2 bits of the flags give the length size, as a power of two.
+ */
+#define STR__PACKED_WIDTH_MASK 0x03
+#define STR__PACKED_TERMINATED 0x04
+
+static size_t str__packed_width_log2 (size_t len) {
+    if (len <= 0xff) {
+        return 0;
+    } else if (len <= 0xffff) {
+        return 1;
+    } else if ((uint64_t)len <= 0xffffffff) {
+        return 2;
+    }
+    return 3;
+}
+
+static unsigned char str__packed_flags (const INH_packed_string * packed) {
+    return *(const unsigned char *)packed;
+}
+
+static size_t str__packed_width (const INH_packed_string * packed) {
+    return (size_t)1 << (str__packed_flags(packed) & STR__PACKED_WIDTH_MASK);
+}
+
+/*
+ * Store a length in the width bytes at base.
+ * The length is in the native byte order, at an unaligned address.
+ */
+static void str__packed_set_len (unsigned char * base, size_t width, size_t len) {
+    switch (width) {
+        case 1: { uint8_t n = (uint8_t)len; memcpy(base, &n, 1); break; }
+        case 2: { uint16_t n = (uint16_t)len; memcpy(base, &n, 2); break; }
+        case 4: { uint32_t n = (uint32_t)len; memcpy(base, &n, 4); break; }
+        default: { uint64_t n = len; memcpy(base, &n, 8); break; }
+    }
+}
+
+/*
+ * Allocate a packed String with room for len characters, and set its length.
+ */
+static INH_packed_string * str__packed_alloc (size_t len, bool terminate) {
+    size_t width_log2 = str__packed_width_log2(len);
+    size_t width = (size_t)1 << width_log2;
+    unsigned char * base = malloc(width + 1 + len + (terminate ? 1 : 0));
+    if (base == NULL) {
+        return NULL;
+    }
+    str__packed_set_len(base, width, len);
+    base[width] = (unsigned char)(width_log2 | (terminate ? STR__PACKED_TERMINATED : 0));
+    if (terminate) {
+        base[width + 1 + len] = '\0';
+    }
+    return (INH_packed_string *)(base + width);
+}
+
+/*
+ * Constructs a new packed String from a C string that is len characters long.
+ * If terminate is true, it also stores a null character after the text.
+ */
+INH_packed_string * str_packed_new_len (const char * stream, size_t len, bool terminate) {
+    INH_packed_string * new = str__packed_alloc(len, terminate);
+    if (new == NULL) {
+        return new;
+    }
+    memcpy(str_packed_data(new), stream, len);
+    return new;
+}
+
+/*
+ * Constructs a new null-terminated packed String from a C string, which must
+ * be null-terminated.
+ */
+INH_packed_string * str_packed_new (const char * stream) {
+    return str_packed_new_len(stream, strlen(stream), true);
+}
+
+/*
+ * Constructs a new packed String from a String.
+ */
+INH_packed_string * str_packed_from (const INH_string * string, bool terminate) {
+    return str_packed_new_len(string->buffer, string->len, terminate);
+}
+
+/*
+ * Constructs a new String from a packed String.
+ */
+INH_string * str_packed_to_string (const INH_packed_string * packed) {
+    INH_view view = str_packed_view(packed);
+    return str_new_len(view.data, view.len);
+}
+
+/*
+ * Returns the number of characters in a packed String.
+ */
+size_t str_packed_len (const INH_packed_string * packed) {
+    const unsigned char * p = (const unsigned char *)packed;
+    switch (str__packed_width(packed)) {
+        case 1: { uint8_t n; memcpy(&n, p - 1, 1); return n; }
+        case 2: { uint16_t n; memcpy(&n, p - 2, 2); return n; }
+        case 4: { uint32_t n; memcpy(&n, p - 4, 4); return n; }
+        default: { uint64_t n; memcpy(&n, p - 8, 8); return (size_t)n; }
+    }
+}
+
+/*
+ * Returns the characters of a packed String, which may be modified in place.
+ */
+char * str_packed_data (INH_packed_string * packed) {
+    return (char *)packed + 1;
+}
+
+/*
+ * View a packed String, to use it with the functions that take views.
+ */
+INH_view str_packed_view (const INH_packed_string * packed) {
+    INH_view view = { (const char *)packed + 1, str_packed_len(packed) };
+    return view;
+}
+
+/*
+ * Returns a packed String as a C string, without copying it.
+ * Returns NULL if the packed String was made without a null character.
+ * Like str_convert, the text stops at any null character inside it.
+ */
+const char * str_packed_cstr (const INH_packed_string * packed) {
+    if (!(str__packed_flags(packed) & STR__PACKED_TERMINATED)) {
+        return NULL;
+    }
+    return (const char *)packed + 1;
+}
+
+/*
+ * Returns the number of bytes allocated for a packed String, not counting
+ * the memory allocator's own overhead.
+ */
+size_t str_packed_alloc_size (const INH_packed_string * packed) {
+    bool terminated = (str__packed_flags(packed) & STR__PACKED_TERMINATED) != 0;
+    return str__packed_width(packed) + 1 + str_packed_len(packed) + (terminated ? 1 : 0);
+}
+
+/*
+ * Duplicate a packed String by allocating a copy of it.
+ */
+INH_packed_string * str_packed_dup (const INH_packed_string * packed) {
+    bool terminated = (str__packed_flags(packed) & STR__PACKED_TERMINATED) != 0;
+    INH_view view = str_packed_view(packed);
+    return str_packed_new_len(view.data, view.len, terminated);
+}
+
+/*
+ * Concatenate viewed characters onto a packed String.
+ * Reallocates the packed String, and moves its text if its length needs
+ * a bigger header.
+ * Returns the packed String pointer, or NULL if memory could not be
+ * allocated, and then the packed String is unchanged.
+ */
+INH_packed_string * str_packed_cat (INH_packed_string * packed, INH_view view) {
+    size_t orig_len = str_packed_len(packed);
+    size_t new_len = orig_len + view.len;
+    bool terminated = (str__packed_flags(packed) & STR__PACKED_TERMINATED) != 0;
+    size_t width = str__packed_width(packed);
+    INH_packed_string * result;
+    if (str__packed_width_log2(new_len) == (str__packed_flags(packed) & STR__PACKED_WIDTH_MASK)) {
+        unsigned char * base = realloc((unsigned char *)packed - width, width + 1 + new_len + (terminated ? 1 : 0));
+        if (base == NULL) {
+            // Realloc failed
+            return NULL;
+        }
+        result = (INH_packed_string *)(base + width);
+        str__packed_set_len(base, width, new_len);
+    } else {
+        result = str__packed_alloc(new_len, terminated);
+        if (result == NULL) {
+            return NULL;
+        }
+        memcpy(str_packed_data(result), str_packed_data(packed), orig_len);
+        str_packed_free(packed);
+    }
+    memcpy(str_packed_data(result) + orig_len, view.data, view.len);
+    if (terminated) {
+        str_packed_data(result)[new_len] = '\0';
+    }
+    return result;
+}
+
+/*
+ * Append a character to a packed String.
+ * Reallocates the packed String.
+ * Returns the packed String pointer.
+ */
+INH_packed_string * str_packed_append (INH_packed_string * packed, char ch) {
+    INH_view view = { &ch, 1 };
+    return str_packed_cat(packed, view);
+}
+
+/*
+ * Returns if two packed Strings are completely equal, including length.
+ */
+bool str_packed_equal (const INH_packed_string * packed1, const INH_packed_string * packed2) {
+    INH_view view1 = str_packed_view(packed1);
+    INH_view view2 = str_packed_view(packed2);
+    return view1.len == view2.len && str__mismatch(view1.data, view2.data, view1.len) == view1.len;
+}
+
+/*
+ * Compare two packed Strings in the same order as str_compare.
+ */
+int str_packed_compare (const INH_packed_string * packed1, const INH_packed_string * packed2) {
+    INH_view view1 = str_packed_view(packed1);
+    INH_view view2 = str_packed_view(packed2);
+    size_t len = (view1.len < view2.len) ? view1.len : view2.len;
+    size_t i = str__mismatch(view1.data, view2.data, len);
+    if (i < len) {
+        return ((unsigned char)view1.data[i] < (unsigned char)view2.data[i]) ? -1 : 1;
+    }
+    return (view1.len > view2.len) - (view1.len < view2.len);
+}
+
+/*
+ * Free a packed String.
+ */
+void str_packed_free (INH_packed_string * packed) {
+    if (packed != NULL) {
+        free((unsigned char *)packed - str__packed_width(packed));
+    }
+}
+
+static uint64_t str__mix64 (uint64_t x) {
+    // The splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/*
+ * Hash the viewed characters. The result is the same on every platform, so
+ * tables written by str_table_write_c can be compiled anywhere.
+ */
+uint64_t str_hash (INH_view view) {
+    const unsigned char * p = (const unsigned char *)view.data;
+    size_t len = view.len;
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ (uint64_t)len;
+    while (len >= 8) {
+        uint64_t word = (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+            ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+            ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+        h = str__mix64(h ^ word);
+        p += 8;
+        len -= 8;
+    }
+    uint64_t word = 0;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        word |= (uint64_t)p[i] << (8 * i);
+    }
+    return str__mix64(h ^ word);
+}
+
+static size_t str__table_bucket (uint64_t hash, size_t bucket_count) {
+    return (size_t)((hash >> 32) % bucket_count);
+}
+
+static size_t str__table_slot (uint64_t hash, uint32_t seed, size_t slot_count) {
+    return (size_t)(str__mix64(hash + seed) % slot_count);
+}
+
+typedef struct str__table_bucket_info {
+    size_t bucket;
+    size_t count;
+} str__table_bucket_info;
+
+static int str__table_bucket_info_compare (const void * a, const void * b) {
+    const str__table_bucket_info * info1 = a;
+    const str__table_bucket_info * info2 = b;
+    // Biggest buckets first, while most slots are still free
+    if (info1->count != info2->count) {
+        return (info1->count < info2->count) ? 1 : -1;
+    }
+    return (info1->bucket > info2->bucket) - (info1->bucket < info2->bucket);
+}
+
+static int str__table_hash_compare (const void * a, const void * b) {
+    uint64_t hash1 = *(const uint64_t *)a;
+    uint64_t hash2 = *(const uint64_t *)b;
+    return (hash1 > hash2) - (hash1 < hash2);
+}
+
+/*
+ * Try to place every key with slot_count slots, by finding a seed for each
+ * bucket of keys that puts them all in free slots ("hash and displace").
+ */
+static bool str__table_place (INH_string_table * table, const INH_string * const keys[], size_t count,
+        const uint64_t * hashes, const INH_string ** slot_keys, int * slot_indices, uint32_t * seeds) {
+    size_t bucket_count = table->bucket_count;
+    size_t slot_count = table->slot_count;
+    str__table_bucket_info * buckets = calloc(bucket_count, sizeof(*buckets));
+    size_t * order = malloc(count * sizeof(*order));
+    size_t * starts = calloc(bucket_count + 1, sizeof(*starts));
+    size_t * tried = malloc(count * sizeof(*tried));
+    bool ok = buckets != NULL && order != NULL && starts != NULL && tried != NULL;
+    size_t i, j;
+
+    if (ok) {
+        // Group the keys by bucket
+        for (i = 0; i < count; i++) {
+            starts[str__table_bucket(hashes[i], bucket_count) + 1]++;
+        }
+        for (i = 0; i < bucket_count; i++) {
+            buckets[i].bucket = i;
+            buckets[i].count = starts[i + 1];
+            starts[i + 1] += starts[i];
+        }
+        // Counting down from each bucket's size fills it from its start
+        for (i = 0; i < count; i++) {
+            size_t bucket = str__table_bucket(hashes[i], bucket_count);
+            size_t placed = starts[bucket + 1] - buckets[bucket].count;
+            order[placed] = i;
+            buckets[bucket].count--;
+        }
+        for (i = 0; i < bucket_count; i++) {
+            buckets[i].count = starts[i + 1] - starts[i];
+        }
+        qsort(buckets, bucket_count, sizeof(*buckets), str__table_bucket_info_compare);
+
+        for (i = 0; i < slot_count; i++) {
+            slot_keys[i] = NULL;
+        }
+        for (i = 0; i < bucket_count; i++) {
+            seeds[i] = 0;
+        }
+    }
+
+    for (i = 0; ok && i < bucket_count && buckets[i].count > 0; i++) {
+        const size_t * members = order + starts[buckets[i].bucket];
+        size_t member_count = buckets[i].count;
+        uint32_t seed;
+        bool placed = false;
+        for (seed = 0; seed < 100000; seed++) {
+            size_t taken = 0;
+            for (j = 0; j < member_count; j++) {
+                size_t slot = str__table_slot(hashes[members[j]], seed, slot_count);
+                if (slot_keys[slot] != NULL) {
+                    break;
+                }
+                // Take the slot for now, so this bucket's other keys can't share it
+                slot_keys[slot] = keys[members[j]];
+                tried[taken++] = slot;
+            }
+            if (j == member_count) {
+                placed = true;
+                break;
+            }
+            while (taken > 0) {
+                slot_keys[tried[--taken]] = NULL;
+            }
+        }
+        if (!placed) {
+            ok = false;
+            break;
+        }
+        seeds[buckets[i].bucket] = seed;
+        for (j = 0; j < member_count; j++) {
+            slot_indices[tried[j]] = (int)members[j];
+        }
+    }
+
+    free(buckets);
+    free(order);
+    free(starts);
+    free(tried);
+    return ok;
+}
+
+/*
+ * Build a perfect hash table for finding the given keys, which must all be
+ * different. The table refers to the keys, which must outlive it.
+ * Returns false if the keys are not all different, or memory could not be
+ * allocated.
+ */
+bool str_table_build (INH_string_table * table, const INH_string * const keys[], size_t count) {
+    table->keys = NULL;
+    table->indices = NULL;
+    table->seeds = NULL;
+    table->bucket_count = count / 2 + 1;
+    table->slot_count = count + count / 4 + 1;
+
+    // The second half is a sorted copy, for finding equal hashes
+    uint64_t * hashes = malloc((count ? 2 * count : 1) * sizeof(*hashes));
+    if (hashes == NULL) {
+        return false;
+    }
+    uint64_t * sorted = hashes + count;
+    size_t i;
+    for (i = 0; i < count; i++) {
+        hashes[i] = str_hash(str_view(keys[i]));
+        sorted[i] = hashes[i];
+    }
+    // Keys with the same hash can't be placed apart
+    qsort(sorted, count, sizeof(*sorted), str__table_hash_compare);
+    for (i = 1; i < count; i++) {
+        if (sorted[i] == sorted[i - 1]) {
+            free(hashes);
+            return false;
+        }
+    }
+
+    bool ok = false;
+    int attempt;
+    for (attempt = 0; attempt < 8 && !ok; attempt++) {
+        const INH_string ** slot_keys = malloc(table->slot_count * sizeof(*slot_keys));
+        int * slot_indices = malloc(table->slot_count * sizeof(*slot_indices));
+        uint32_t * seeds = malloc(table->bucket_count * sizeof(*seeds));
+        if (slot_keys != NULL && slot_indices != NULL && seeds != NULL) {
+            ok = str__table_place(table, keys, count, hashes, slot_keys, slot_indices, seeds);
+        }
+        if (ok) {
+            for (i = 0; i < table->slot_count; i++) {
+                if (slot_keys[i] == NULL) {
+                    slot_indices[i] = -1;
+                }
+            }
+            table->keys = slot_keys;
+            table->indices = slot_indices;
+            table->seeds = seeds;
+        } else {
+            free((void *)slot_keys);
+            free(slot_indices);
+            free(seeds);
+            if (slot_keys == NULL || slot_indices == NULL || seeds == NULL) {
+                break;
+            }
+            // Try again with more room
+            table->slot_count += table->slot_count / 2;
+        }
+    }
+    free(hashes);
+    return ok;
+}
+
+/*
+ * Find a key in a perfect hash table.
+ * Returns the index of the key in the list the table was built from, or -1
+ * if it is not one of the keys.
+ */
+int str_table_find (const INH_string_table * table, INH_view key) {
+    uint64_t hash = str_hash(key);
+    uint32_t seed = table->seeds[str__table_bucket(hash, table->bucket_count)];
+    size_t slot = str__table_slot(hash, seed, table->slot_count);
+    const INH_string * found = table->keys[slot];
+    if (found == NULL || found->len != key.len || str__mismatch(found->buffer, key.data, key.len) != key.len) {
+        return -1;
+    }
+    return table->indices[slot];
+}
+
+/*
+ * Write a perfect hash table as C code that defines a static
+ * INH_string_table with the given name, with its keys as STR_LITERALs.
+ * The code needs inh_string.h to be included before it.
+ *
+ * Returns:
+ * On success, returns a non-negative value
+ * On failure, returns EOF and sets the error indicator (see ferror()) on stream.
+ */
+int str_table_write_c (const INH_string_table * table, FILE * stream, const char * name) {
+    size_t i, j;
+    fprintf(stream, "// Perfect hash table generated by str_table_write_c\n");
+    fprintf(stream, "static const INH_string * const %s_keys[%zu] = {\n", name, table->slot_count);
+    for (i = 0; i < table->slot_count; i++) {
+        const INH_string * key = table->keys[i];
+        if (key == NULL) {
+            fprintf(stream, "    NULL,\n");
+            continue;
+        }
+        fprintf(stream, "    STR_LITERAL(\"");
+        for (j = 0; j < key->len; j++) {
+            unsigned char c = key->buffer[j];
+            if (c >= ' ' && c <= '~' && c != '"' && c != '\\' && c != '?') {
+                putc(c, stream);
+            } else {
+                // Always 3 octal digits, so a following digit isn't part of it
+                fprintf(stream, "\\%03o", c);
+            }
+        }
+        fprintf(stream, "\"),\n");
+    }
+    fprintf(stream, "};\n");
+
+    fprintf(stream, "static const int %s_indices[%zu] = {", name, table->slot_count);
+    for (i = 0; i < table->slot_count; i++) {
+        fprintf(stream, "%s%d,", (i % 16) ? " " : "\n    ", table->indices[i]);
+    }
+    fprintf(stream, "\n};\n");
+
+    fprintf(stream, "static const uint32_t %s_seeds[%zu] = {", name, table->bucket_count);
+    for (i = 0; i < table->bucket_count; i++) {
+        fprintf(stream, "%s%lu,", (i % 16) ? " " : "\n    ", (unsigned long)table->seeds[i]);
+    }
+    fprintf(stream, "\n};\n");
+
+    fprintf(stream, "static const INH_string_table %s = { %s_keys, %s_indices, %s_seeds, %zu, %zu };\n",
+            name, name, name, name, table->bucket_count, table->slot_count);
+    return ferror(stream) ? EOF : 1;
+}
+
+/*
+ * Free a table made by str_table_build, but not its keys.
+ */
+void str_table_free (INH_string_table * table) {
+    free((void *)table->keys);
+    free((void *)table->indices);
+    free((void *)table->seeds);
+    table->keys = NULL;
+    table->indices = NULL;
+    table->seeds = NULL;
+}
+
+// --- End of implementation --- //
+
+#endif // INH_STRING_IMPLEMENTATION
+
+/***
+
+= inh_string.h 0.1.0 =
+
+This is a single file header for the use of length-encoded Strings in the C
+Programming language.
+
+== Usage ==
+
+Write the following to use the file as a normal header:
+
+ #include "inh_string.h"
+
+and then in one and only one file, write the following after including any 
+files that depend on this header:
+
+ #define INH_STRING_IMPLEMENTATION
  #include "inh_string.h"
 
 If you want the implementation to be private to the file that defines
@@ -460,6 +3488,27 @@ INH_STRING_IMPLEMENTATION, you can write the following instead:
  #define INH_STRING_IMPLEMENTATION
  #include "inh_string.h"
 
+Some functions use SSE2 instructions when the compiler targets them. To always
+use the plain C versions, write the following before the implementation:
+
+ #define INH_STRING_NO_SIMD
+
+To share Strings between owners without copying them, write the following
+before every include of this file (it changes the String structure, and
+needs C11 atomics):
+
+ #define INH_STRING_REFCOUNT
+
+Then str_retain adds an owner, str_release removes one, and functions that
+modify or resize a String copy it first if it is shared. Without it,
+str_retain copies and str_release frees.
+
+To use functions that start threads, like str_reader_start_read_ahead (which
+only reads ahead from regular files), write the following before every include
+of this file and link with pthreads:
+
+ #define INH_STRING_THREADS
+
 == Changelog ==
 
 All notable changes to this project will be documented in this section.
@@ -469,6 +3518,32 @@ and this project adheres to [Semantic Versioning](https://semver.org/spec/v2.0.0
 
 This project uses semantic versioning [https://semver.org].
 
+=== [Unreleased] ===
+==== Added ====
+* Case conversion, trimming, character replacement, and byte table translate
+  and filter functions, with in-place and copying variants
+* INH_view type for non-owning views of characters
+* Integer and shortest round-trip double formatting (str_append_*) and
+  parsing (str_parse_*)
+* Optional atomic reference counting with copy-on-write (INH_STRING_REFCOUNT),
+  and str_retain, str_release, str_is_shared and str_unshare
+* INH_string_list for collecting text without copying, then flattening it or
+  writing it out with writev
+* INH_string_reader for splitting a FILE * or file descriptor into records,
+  with optional read-ahead on a background thread (INH_STRING_THREADS)
+* str_compare for lexicographic order, and str_sort (multikey quicksort with
+  cached prefixes) and str_sort_parallel for sorting arrays of Strings
+* INH_string_builder, with printf-style appends into its spare room and JSON
+  string and CSV field escaping
+* INH_packed_string, with a 1, 2, 4 or 8 byte length header and an optional
+  null character, to save memory on short strings
+* STR_LITERAL for String literals without heap allocation, and
+  INH_string_table perfect hash tables that can be written out as C code
+
+==== Changed ====
+* Copying, writing and comparing Strings use memcpy, memchr and SSE2 instead
+  of character loops, checked against the old loops by test/inh_string_fuzz.c
+
 === [0.1.0] - 2021-03-20 ===
 ==== Added ====
 * This changelog
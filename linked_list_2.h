@@ -1,3 +1,4 @@
+#include <stdatomic.h>
 #include <stdlib.h>
 
 /*
@@ -17,6 +18,18 @@ struct LinkedNode2
 	struct LinkedNode2 * previous;
 	struct LinkedNode2 * next;
 	void*data_pointer;
+	struct LinkedNodeBlock2 * block;
+};
+
+/*
+ * Nodes allocated together in one block, which is freed when the last of its
+ * nodes is freed. Its nodes may end up in lists freed by different threads,
+ * so they are counted atomically.
+ */
+struct LinkedNodeBlock2
+{
+	atomic_int live_count;
+	struct LinkedNode2 nodes[];
 };
 
 struct LinkedList2
@@ -66,6 +79,18 @@ struct LinkedList2 * linkedlist2_copy_array (void * array, int length);
 
 struct LinkedList2 * linkedlist2_list_allocate (int start_length);
 
+struct LinkedNode2 * linkedlist2_nodes_allocate (void ** data, int count);
+
+void linkedlist2_append_array (struct LinkedList2 *, void ** array, int length);
+
+int linkedlist2_to_array (struct LinkedList2 *, void ** array);
+
+void linkedlist2_concat (struct LinkedList2 * dest, struct LinkedList2 * source);
+
+void linkedlist2_splice (struct LinkedList2 * dest, struct LinkedNode2 * after, struct LinkedList2 * source, struct LinkedNode2 * first, struct LinkedNode2 * last, int count);
+
+struct LinkedList2 * linkedlist2_split_at_node (struct LinkedList2 *, struct LinkedNode2 * node, int node_index);
+
 /*
  * Begin function implementations...
  */
@@ -73,23 +98,48 @@ struct LinkedList2 * linkedlist2_list_allocate (int start_length);
 struct LinkedNode2 * linkedlist2_node_allocate
 (void * data_pointer)
 {
-	struct Linked2Node*node = malloc(sizeof(struct Linked2Node));
+	struct LinkedNode2 * node = malloc(sizeof(struct LinkedNode2));
+	node->previous = NULL;
+	node->next = NULL;
 	node->data_pointer = data_pointer;
+	node->block = NULL;
 	return node;
 }
 
+/*
+ * Allocate count nodes in one block, already linked together in order, and
+ * holding the data pointers from the data array (or NULL when data is NULL).
+ * Returns the first node.
+ */
+struct LinkedNode2 * linkedlist2_nodes_allocate
+(void ** data, int count)
+{
+	struct LinkedNodeBlock2 * block = malloc(sizeof(struct LinkedNodeBlock2) + count * sizeof(struct LinkedNode2));
+	struct LinkedNode2 * nodes = block->nodes;
+	atomic_init(&block->live_count, count);
+	int i;
+	for(i = 0; i < count; i++)
+	{
+		nodes[i].previous = (i > 0)? &nodes[i - 1] : NULL;
+		nodes[i].next = (i < count - 1)? &nodes[i + 1] : NULL;
+		nodes[i].data_pointer = (data != NULL)? data[i] : NULL;
+		nodes[i].block = block;
+	}
+	return nodes;
+}
+
 void linkedlist2_reverse
 (struct LinkedList2 * list)
 {
 	struct LinkedNode2 * head = list->head;
-	if(head! = NULL)
+	if(head != NULL)
 	{
 		list->head = list->tail;
 		list->tail = head;
-		while(head! = NULL)
+		while(head != NULL)
 		{
 			struct LinkedNode2*next = head->next;
-			head->next = previous;
+			head->next = head->previous;
 			head->previous = next;
 			head = next;
 		}
@@ -150,14 +200,42 @@ void linkedlist2_node_remove
 void linkedlist2_node_free
 (struct LinkedNode2*node)
 {
-	free(node);
+	struct LinkedNodeBlock2 * block = node->block;
+	if(block == NULL)
+	{
+		free(node);
+	}
+	else if(atomic_fetch_sub_explicit(&block->live_count, 1, memory_order_acq_rel) == 1)
+	{
+		free(block);
+	}
+}
+
+void linkedlist2_free
+(struct LinkedList2 * list)
+{
+	struct LinkedNode2 * element = list->head;
+	while(element != NULL)
+	{
+		struct LinkedNode2 * next = element->next;
+		linkedlist2_node_free(element);
+		element = next;
+	}
+	free(list);
 }
 
 void linkedlist2_append
 (struct LinkedList2 * list, void * data)
 {
-	struct LinkedNode2 * new = linkedlist2_node_alloc(data);
-	list->tail->next = new;
+	struct LinkedNode2 * new = linkedlist2_node_allocate(data);
+	if(list->tail != NULL)
+	{
+		list->tail->next = new;
+	}
+	else
+	{
+		list->head = new;
+	}
 	new->previous = list->tail;
 	new->next = NULL;
 	list->length++;
@@ -167,8 +245,15 @@ void linkedlist2_append
 void linkedlist2_prepend
 (struct LinkedList2*list,void*data)
 {
-	struct LinkedNode2*new = linkedlist2_node_alloc(data);
-	list->head->prev = new;
+	struct LinkedNode2*new = linkedlist2_node_allocate(data);
+	if(list->head != NULL)
+	{
+		list->head->previous = new;
+	}
+	else
+	{
+		list->tail = new;
+	}
 	new->previous = NULL;
 	new->next = list->head;
 	list->length++;
@@ -195,19 +280,222 @@ struct LinkedList2 * linkedlist2_list_allocate
 (int length)
 {
 	struct LinkedList2 * list = malloc(sizeof(struct LinkedList2));
-	struct LinkedNode2 * prev = linkedlist2_node_allocate(NULL);
-	struct LinkedNode2 * element;
-	list->head = prev;
+	list->head = NULL;
+	list->tail = NULL;
+	list->length = 0;
 	int i;
 	for(i = 0; i < length; i++)
 	{
-		element = linkedlist2_node_allocate(NULL);
-		prev->next = element;
-		element->previous = prev;
-		prev = element;
+		linkedlist2_append(list, NULL);
+	}
+	return list;
+}
+
+void linkedlist2_update_length
+(struct LinkedList2 * list)
+{
+	int length = 0;
+	struct LinkedNode2 * node;
+	for(node = list->head; node != NULL; node = node->next)
+	{
+		length++;
 	}
-	element->next = NULL;
 	list->length = length;
+}
+
+/*
+ * Append the data pointers in array to the list, with all of the new nodes
+ * allocated in one block.
+ */
+void linkedlist2_append_array
+(struct LinkedList2 * list, void ** array, int length)
+{
+	if(length <= 0)
+	{
+		return;
+	}
+	struct LinkedNode2 * first = linkedlist2_nodes_allocate(array, length);
+	first->previous = list->tail;
+	if(list->tail != NULL)
+	{
+		list->tail->next = first;
+	}
+	else
+	{
+		list->head = first;
+	}
+	list->tail = &first[length - 1];
+	list->length += length;
+}
+
+struct LinkedList2 * linkedlist2_copy_array
+(void * array, int length)
+{
+	struct LinkedList2 * list = malloc(sizeof(struct LinkedList2));
+	list->head = NULL;
+	list->tail = NULL;
+	list->length = 0;
+	linkedlist2_append_array(list, array, length);
 	return list;
 }
 
+struct LinkedList2 * linkedlist2_copy
+(struct LinkedList2 * list)
+{
+	struct LinkedList2 * copy = malloc(sizeof(struct LinkedList2));
+	copy->head = NULL;
+	copy->tail = NULL;
+	copy->length = list->length;
+	if(list->length > 0)
+	{
+		struct LinkedNode2 * nodes = linkedlist2_nodes_allocate(NULL, list->length);
+		struct LinkedNode2 * element = list->head;
+		int i;
+		for(i = 0; i < list->length; i++)
+		{
+			nodes[i].data_pointer = element->data_pointer;
+			element = element->next;
+		}
+		copy->head = nodes;
+		copy->tail = &nodes[list->length - 1];
+	}
+	return copy;
+}
+
+/*
+ * Write the list's data pointers to array, which must have room for all
+ * of them.
+ * Returns the number of data pointers written.
+ */
+int linkedlist2_to_array
+(struct LinkedList2 * list, void ** array)
+{
+	int n = 0;
+	struct LinkedNode2 * element;
+	for(element = list->head; element != NULL; element = element->next)
+	{
+		array[n++] = element->data_pointer;
+	}
+	return n;
+}
+
+/*
+ * Move all of the nodes in source to the end of dest, leaving source empty.
+ */
+void linkedlist2_concat
+(struct LinkedList2 * dest, struct LinkedList2 * source)
+{
+	if(source->head == NULL)
+	{
+		return;
+	}
+	if(dest->tail != NULL)
+	{
+		dest->tail->next = source->head;
+		source->head->previous = dest->tail;
+	}
+	else
+	{
+		dest->head = source->head;
+	}
+	dest->tail = source->tail;
+	dest->length += source->length;
+	source->head = NULL;
+	source->tail = NULL;
+	source->length = 0;
+}
+
+/*
+ * Move the nodes first...last (inclusive) out of source and into dest, just
+ * after the node after (or at the front of dest when after is NULL).
+ * count is the number of nodes moved, or -1 to have them counted.
+ */
+void linkedlist2_splice
+(struct LinkedList2 * dest, struct LinkedNode2 * after, struct LinkedList2 * source, struct LinkedNode2 * first, struct LinkedNode2 * last, int count)
+{
+	if(count < 0)
+	{
+		struct LinkedNode2 * element;
+		count = 1;
+		for(element = first; element != last; element = element->next)
+		{
+			count++;
+		}
+	}
+
+	/* Unlink the nodes from source */
+	if(first->previous != NULL)
+	{
+		first->previous->next = last->next;
+	}
+	else
+	{
+		source->head = last->next;
+	}
+	if(last->next != NULL)
+	{
+		last->next->previous = first->previous;
+	}
+	else
+	{
+		source->tail = first->previous;
+	}
+	source->length -= count;
+
+	/* Link the nodes into dest */
+	struct LinkedNode2 * next = (after != NULL)? after->next : dest->head;
+	first->previous = after;
+	last->next = next;
+	if(after != NULL)
+	{
+		after->next = first;
+	}
+	else
+	{
+		dest->head = first;
+	}
+	if(next != NULL)
+	{
+		next->previous = last;
+	}
+	else
+	{
+		dest->tail = last;
+	}
+	dest->length += count;
+}
+
+/*
+ * Split the list before node, and move node and the nodes after it into
+ * a new list.
+ * node_index is the index of node, or -1 to have the lengths counted again.
+ * Returns the new list.
+ */
+struct LinkedList2 * linkedlist2_split_at_node
+(struct LinkedList2 * list, struct LinkedNode2 * node, int node_index)
+{
+	struct LinkedList2 * rest = malloc(sizeof(struct LinkedList2));
+	rest->head = node;
+	rest->tail = list->tail;
+	list->tail = node->previous;
+	if(list->tail != NULL)
+	{
+		list->tail->next = NULL;
+	}
+	else
+	{
+		list->head = NULL;
+	}
+	node->previous = NULL;
+	if(node_index >= 0)
+	{
+		rest->length = list->length - node_index;
+		list->length = node_index;
+	}
+	else
+	{
+		linkedlist2_update_length(list);
+		linkedlist2_update_length(rest);
+	}
+	return rest;
+}
@@ -0,0 +1,56 @@
+// Perfect hash table generated by str_table_write_c
+static const INH_string * const c_keywords_keys[43] = {
+    STR_LITERAL("for"),
+    NULL,
+    STR_LITERAL("else"),
+    NULL,
+    STR_LITERAL("float"),
+    STR_LITERAL("auto"),
+    NULL,
+    NULL,
+    STR_LITERAL("volatile"),
+    STR_LITERAL("signed"),
+    STR_LITERAL("double"),
+    STR_LITERAL("break"),
+    STR_LITERAL("union"),
+    STR_LITERAL("static"),
+    STR_LITERAL(""),
+    STR_LITERAL("do"),
+    STR_LITERAL("short"),
+    STR_LITERAL("int"),
+    NULL,
+    STR_LITERAL("continue"),
+    STR_LITERAL("enum"),
+    STR_LITERAL("const"),
+    STR_LITERAL("void"),
+    STR_LITERAL("case"),
+    STR_LITERAL("char"),
+    STR_LITERAL("sizeof"),
+    STR_LITERAL("if"),
+    STR_LITERAL("unsigned"),
+    NULL,
+    STR_LITERAL("with\000null"),
+    STR_LITERAL("return"),
+    STR_LITERAL("while"),
+    STR_LITERAL("switch"),
+    STR_LITERAL("struct"),
+    STR_LITERAL("default"),
+    NULL,
+    STR_LITERAL("long"),
+    STR_LITERAL("goto"),
+    NULL,
+    STR_LITERAL("register"),
+    STR_LITERAL("typedef"),
+    NULL,
+    STR_LITERAL("extern"),
+};
+static const int c_keywords_indices[43] = {
+    13, -1, 9, -1, 12, 0, -1, -1, 30, 21, 8, 1, 27, 23, 32, 7,
+    20, 16, -1, 5, 10, 4, 29, 2, 3, 22, 15, 28, -1, 33, 19, 31,
+    25, 24, 6, -1, 17, 14, -1, 18, 26, -1, 11,
+};
+static const uint32_t c_keywords_seeds[18] = {
+    1, 3, 0, 3, 3, 0, 0, 4, 0, 1, 1, 0, 5, 1, 7, 0,
+    0, 4,
+};
+static const INH_string_table c_keywords = { c_keywords_keys, c_keywords_indices, c_keywords_seeds, 18, 43 };
@@ -0,0 +1,209 @@
+/*
+ * Times passing items between threads through INH_spsc_queue and
+ * INH_mpmc_queue, against a LinkedList2 guarded by a mutex, for several
+ * numbers of producer and consumer threads:
+ *
+ *  cc -O2 -pthread inh_queue_bench.c -o inh_queue_bench && ./inh_queue_bench [items]
+ *
+ * Add -DINH_QUEUE_BLOCKING to time the queues with waiting threads sleeping
+ * instead of yielding.
+ */
+
+// For clock_gettime
+#define _POSIX_C_SOURCE 200809L
+
+// linked_list_2.h defines its own bool
+#include "../linked_list_2.h"
+
+#define INH_QUEUE_NO_STDBOOL
+#define INH_QUEUE_IMPLEMENTATION
+#include "../inh_queue.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define QUEUE_CAPACITY 1024
+#define BATCH 16
+
+/*
+ * The baseline: a LinkedList2 used as a FIFO, where popping waits on a
+ * condition variable while the list is empty.
+ */
+typedef struct locked_list {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    struct LinkedList2 list;
+} locked_list;
+
+void locked_list_push (locked_list * list, void * item) {
+    pthread_mutex_lock(&list->lock);
+    linkedlist2_append(&list->list, item);
+    pthread_cond_signal(&list->not_empty);
+    pthread_mutex_unlock(&list->lock);
+}
+
+void * locked_list_pop (locked_list * list) {
+    pthread_mutex_lock(&list->lock);
+    while (list->list.head == NULL) {
+	pthread_cond_wait(&list->not_empty, &list->lock);
+    }
+    struct LinkedNode2 * node = list->list.head;
+    list->list.head = node->next;
+    if (list->list.head != NULL) {
+	list->list.head->previous = NULL;
+    } else {
+	list->list.tail = NULL;
+    }
+    list->list.length--;
+    pthread_mutex_unlock(&list->lock);
+    void * item = node->data_pointer;
+    linkedlist2_node_free(node);
+    return item;
+}
+
+typedef enum { KIND_LIST, KIND_SPSC, KIND_MPMC, KIND_MPMC_BATCH } queue_kind;
+
+typedef struct bench {
+    queue_kind kind;
+    void * queue;
+    size_t items; // For each thread
+    intptr_t sum;
+} bench;
+
+void * producer (void * arg) {
+    bench * b = arg;
+    size_t i;
+    if (b->kind == KIND_MPMC_BATCH) {
+	void * items[BATCH];
+	for (i = 0; i < b->items; ) {
+	    size_t n = 0;
+	    while (n < BATCH && i + n < b->items) {
+		items[n] = (void *)(i + n + 1);
+		n++;
+	    }
+	    size_t pushed = mpmc_queue_push_batch(b->queue, items, n);
+	    if (pushed == 0) {
+		// Wait for room
+		mpmc_queue_push_wait(b->queue, items[0]);
+		pushed = 1;
+	    }
+	    i += pushed;
+	}
+	return NULL;
+    }
+    for (i = 1; i <= b->items; i++) {
+	switch (b->kind) {
+	    case KIND_LIST: locked_list_push(b->queue, (void *)i); break;
+	    case KIND_SPSC: spsc_queue_push_wait(b->queue, (void *)i); break;
+	    default: mpmc_queue_push_wait(b->queue, (void *)i); break;
+	}
+    }
+    return NULL;
+}
+
+void * consumer (void * arg) {
+    bench * b = arg;
+    intptr_t sum = 0;
+    size_t i;
+    if (b->kind == KIND_MPMC_BATCH) {
+	void * items[BATCH];
+	for (i = 0; i < b->items; ) {
+	    size_t want = b->items - i;
+	    size_t n = mpmc_queue_pop_batch(b->queue, items, (want < BATCH) ? want : BATCH);
+	    if (n == 0) {
+		// Wait for an item
+		items[0] = mpmc_queue_pop_wait(b->queue);
+		n = 1;
+	    }
+	    size_t j;
+	    for (j = 0; j < n; j++) {
+		sum += (intptr_t)items[j];
+	    }
+	    i += n;
+	}
+	b->sum = sum;
+	return NULL;
+    }
+    for (i = 0; i < b->items; i++) {
+	switch (b->kind) {
+	    case KIND_LIST: sum += (intptr_t)locked_list_pop(b->queue); break;
+	    case KIND_SPSC: sum += (intptr_t)spsc_queue_pop_wait(b->queue); break;
+	    default: sum += (intptr_t)mpmc_queue_pop_wait(b->queue); break;
+	}
+    }
+    b->sum = sum;
+    return NULL;
+}
+
+double seconds (void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/*
+ * Pass total items from the producers to the consumers.
+ * Returns the wall clock time in nanoseconds per item.
+ */
+double run (queue_kind kind, int producers, int consumers, size_t total) {
+    locked_list list = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, { NULL, NULL, 0 } };
+    void * queue = &list;
+    if (kind == KIND_SPSC) {
+	queue = spsc_queue_create(QUEUE_CAPACITY);
+    } else if (kind != KIND_LIST) {
+	queue = mpmc_queue_create(QUEUE_CAPACITY);
+    }
+    bench benches[16];
+    pthread_t threads[16];
+    int t;
+    double start = seconds();
+    for (t = 0; t < producers + consumers; t++) {
+	benches[t].kind = kind;
+	benches[t].queue = queue;
+	benches[t].items = total / ((t < producers) ? producers : consumers);
+	benches[t].sum = 0;
+	pthread_create(&threads[t], NULL, (t < producers) ? producer : consumer, &benches[t]);
+    }
+    intptr_t sum = 0;
+    for (t = 0; t < producers + consumers; t++) {
+	pthread_join(threads[t], NULL);
+	sum += benches[t].sum;
+    }
+    double elapsed = seconds() - start;
+
+    intptr_t per_producer = (intptr_t)(total / producers);
+    if (sum != producers * (per_producer * (per_producer + 1) / 2)) {
+	fprintf(stderr, "items were lost or repeated\n");
+	exit(1);
+    }
+    if (kind == KIND_SPSC) {
+	spsc_queue_destroy(queue);
+    } else if (kind != KIND_LIST) {
+	mpmc_queue_destroy(queue);
+    }
+    return elapsed * 1e9 / total;
+}
+
+int main (int argc, char * argv[]) {
+    size_t total = (argc > 1) ? (size_t)atol(argv[1]) : (1u << 20);
+    // Each count divides total when total is a multiple of 8
+    int counts[][2] = { {1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}, {8, 8} };
+    size_t c;
+    total -= total % 8;
+    printf("%10s %10s %12s %12s %12s %12s\n", "producers", "consumers", "list ns", "spsc ns", "mpmc ns", "mpmc batch ns");
+    for (c = 0; c < sizeof(counts) / sizeof(*counts); c++) {
+	int producers = counts[c][0];
+	int consumers = counts[c][1];
+	printf("%10d %10d %12.1f ", producers, consumers, run(KIND_LIST, producers, consumers, total));
+	if (producers == 1 && consumers == 1) {
+	    printf("%12.1f ", run(KIND_SPSC, 1, 1, total));
+	} else {
+	    printf("%12s ", "-");
+	}
+	printf("%12.1f ", run(KIND_MPMC, producers, consumers, total));
+	printf("%12.1f\n", run(KIND_MPMC_BATCH, producers, consumers, total));
+    }
+    return 0;
+}
@@ -0,0 +1,234 @@
+// Build these tests with and without -DINH_QUEUE_BLOCKING, which changes
+// how the _wait functions wait.
+
+#define INH_QUEUE_IMPLEMENTATION
+#include "../inh_queue.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define ITEMS_PER_PRODUCER 200000
+#define BATCH_PRODUCERS 3
+
+void test_spsc_queue (void) {
+    INH_spsc_queue * queue = spsc_queue_create(5);
+    assert(queue != NULL);
+    assert(spsc_queue_capacity(queue) == 8);
+
+    void * item;
+    assert(!spsc_queue_pop(queue, &item));
+    intptr_t i;
+    for (i = 1; i <= 8; i++) {
+	assert(spsc_queue_push(queue, (void *)i));
+    }
+    assert(!spsc_queue_push(queue, (void *)9));
+    for (i = 1; i <= 8; i++) {
+	assert(spsc_queue_pop(queue, &item));
+	assert(item == (void *)i);
+    }
+    assert(!spsc_queue_pop(queue, &item));
+
+    // batches that wrap around the end of the slots
+    void * items[10] = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5, (void *)6, (void *)7};
+    void * out[10];
+    assert(spsc_queue_push_batch(queue, items, 5) == 5);
+    assert(spsc_queue_pop_batch(queue, out, 3) == 3);
+    assert(spsc_queue_push_batch(queue, items, 7) == 6);
+    assert(spsc_queue_pop_batch(queue, out, 10) == 8);
+    assert(out[0] == (void *)4 && out[1] == (void *)5 && out[2] == (void *)1 && out[7] == (void *)6);
+
+    spsc_queue_destroy(queue);
+
+    // capacities that can't be rounded up to a power of two
+    assert(spsc_queue_create(SIZE_MAX) == NULL);
+    assert(spsc_queue_create(SIZE_MAX / 2 + 2) == NULL);
+    assert(spsc_queue_create(SIZE_MAX / 2 + 1) == NULL);
+}
+
+void test_mpmc_queue (void) {
+    INH_mpmc_queue * queue = mpmc_queue_create(4);
+    assert(queue != NULL);
+    assert(mpmc_queue_capacity(queue) == 4);
+
+    void * item;
+    assert(!mpmc_queue_pop(queue, &item));
+    intptr_t i;
+    for (i = 1; i <= 4; i++) {
+	assert(mpmc_queue_push(queue, (void *)i));
+    }
+    assert(!mpmc_queue_push(queue, (void *)5));
+    for (i = 1; i <= 4; i++) {
+	assert(mpmc_queue_pop(queue, &item));
+	assert(item == (void *)i);
+    }
+    assert(!mpmc_queue_pop(queue, &item));
+
+    void * items[6] = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5, (void *)6};
+    void * out[6];
+    assert(mpmc_queue_push_batch(queue, items, 3) == 3);
+    assert(mpmc_queue_pop_batch(queue, out, 2) == 2);
+    assert(mpmc_queue_push_batch(queue, items + 3, 3) == 3);
+    assert(mpmc_queue_pop_batch(queue, out, 6) == 4);
+    assert(out[0] == (void *)3 && out[1] == (void *)4 && out[3] == (void *)6);
+
+    mpmc_queue_destroy(queue);
+
+    assert(mpmc_queue_create(SIZE_MAX) == NULL);
+    assert(mpmc_queue_create(SIZE_MAX / 2 + 2) == NULL);
+}
+
+void * spsc_producer (void * arg) {
+    INH_spsc_queue * queue = arg;
+    intptr_t i;
+    for (i = 1; i <= ITEMS_PER_PRODUCER; i++) {
+	spsc_queue_push_wait(queue, (void *)i);
+    }
+    return NULL;
+}
+
+void test_spsc_queue_threads (void) {
+    INH_spsc_queue * queue = spsc_queue_create(64);
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, spsc_producer, queue) == 0);
+
+    // items arrive in order
+    intptr_t expected = 1;
+    void * items[16];
+    while (expected <= ITEMS_PER_PRODUCER) {
+	size_t n = spsc_queue_pop_batch(queue, items, 16);
+	size_t i;
+	for (i = 0; i < n; i++) {
+	    assert(items[i] == (void *)expected);
+	    expected++;
+	}
+    }
+    pthread_join(producer, NULL);
+    spsc_queue_destroy(queue);
+}
+
+void * mpmc_producer (void * arg) {
+    INH_mpmc_queue * queue = arg;
+    intptr_t i;
+    for (i = 1; i <= ITEMS_PER_PRODUCER; i++) {
+	mpmc_queue_push_wait(queue, (void *)i);
+    }
+    return NULL;
+}
+
+void * mpmc_consumer (void * arg) {
+    INH_mpmc_queue * queue = arg;
+    intptr_t sum = 0;
+    intptr_t i;
+    for (i = 0; i < ITEMS_PER_PRODUCER; i++) {
+	sum += (intptr_t)mpmc_queue_pop_wait(queue);
+    }
+    return (void *)sum;
+}
+
+void test_mpmc_queue_threads (void) {
+    // every item is taken exactly once
+    INH_mpmc_queue * queue = mpmc_queue_create(64);
+    pthread_t producers[3];
+    pthread_t consumers[3];
+    int t;
+    for (t = 0; t < 3; t++) {
+	assert(pthread_create(&producers[t], NULL, mpmc_producer, queue) == 0);
+	assert(pthread_create(&consumers[t], NULL, mpmc_consumer, queue) == 0);
+    }
+    intptr_t sum = 0;
+    for (t = 0; t < 3; t++) {
+	void * result;
+	pthread_join(producers[t], NULL);
+	pthread_join(consumers[t], &result);
+	sum += (intptr_t)result;
+    }
+    assert(sum == 3 * ((intptr_t)ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2));
+    mpmc_queue_destroy(queue);
+}
+
+/*
+ * Items from producer p are p + BATCH_PRODUCERS * i for i = 1, 2, 3...
+ */
+void * mpmc_batch_producer (void * arg) {
+    INH_mpmc_queue * queue = ((void **)arg)[0];
+    intptr_t producer = (intptr_t)((void **)arg)[1];
+    void * items[7];
+    intptr_t next = 1;
+    size_t batch = 1;
+    while (next <= ITEMS_PER_PRODUCER) {
+	size_t n = 0;
+	while (n < batch && next + (intptr_t)n <= ITEMS_PER_PRODUCER) {
+	    items[n] = (void *)(producer + BATCH_PRODUCERS * (next + (intptr_t)n));
+	    n++;
+	}
+	size_t pushed = mpmc_queue_push_batch(queue, items, n);
+	if (pushed == 0) {
+	    sched_yield();
+	}
+	next += pushed;
+	batch = batch % 7 + 1;
+    }
+    return NULL;
+}
+
+void * mpmc_batch_consumer (void * arg) {
+    INH_mpmc_queue * queue = arg;
+    // one consumer sees each producer's items in order, though it may not see all of them
+    intptr_t last[BATCH_PRODUCERS] = {0};
+    intptr_t sum = 0;
+    intptr_t taken = 0;
+    void * items[5];
+    while (taken < ITEMS_PER_PRODUCER) {
+	size_t want = (size_t)(ITEMS_PER_PRODUCER - taken);
+	size_t n = mpmc_queue_pop_batch(queue, items, (want < 5) ? want : 5);
+	if (n == 0) {
+	    sched_yield();
+	}
+	size_t i;
+	for (i = 0; i < n; i++) {
+	    intptr_t item = (intptr_t)items[i];
+	    intptr_t producer = item % BATCH_PRODUCERS;
+	    assert(item > last[producer]);
+	    last[producer] = item;
+	    sum += item;
+	}
+	taken += n;
+    }
+    return (void *)sum;
+}
+
+void test_mpmc_queue_batch_threads (void) {
+    INH_mpmc_queue * queue = mpmc_queue_create(32);
+    pthread_t producers[BATCH_PRODUCERS];
+    pthread_t consumers[BATCH_PRODUCERS];
+    void * args[BATCH_PRODUCERS][2];
+    intptr_t t;
+    for (t = 0; t < BATCH_PRODUCERS; t++) {
+	args[t][0] = queue;
+	args[t][1] = (void *)t;
+	assert(pthread_create(&producers[t], NULL, mpmc_batch_producer, args[t]) == 0);
+	assert(pthread_create(&consumers[t], NULL, mpmc_batch_consumer, queue) == 0);
+    }
+    intptr_t sum = 0;
+    intptr_t expected = 0;
+    for (t = 0; t < BATCH_PRODUCERS; t++) {
+	void * result;
+	pthread_join(producers[t], NULL);
+	pthread_join(consumers[t], &result);
+	sum += (intptr_t)result;
+	expected += ITEMS_PER_PRODUCER * t + BATCH_PRODUCERS * ((intptr_t)ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2);
+    }
+    assert(sum == expected);
+    mpmc_queue_destroy(queue);
+}
+
+int main () {
+    test_spsc_queue();
+    test_mpmc_queue();
+    test_spsc_queue_threads();
+    test_mpmc_queue_threads();
+    test_mpmc_queue_batch_threads();
+}
@@ -0,0 +1,843 @@
+/*
+ * Differential tests for inh_string.h: each fast routine is run against a
+ * plain reference version on the same input, and must give the same result.
+ *
+ * As a standalone program, it checks random inputs and then times the fast
+ * and reference versions for several input sizes:
+ *
+ *  cc -O2 inh_string_fuzz.c -o inh_string_fuzz && ./inh_string_fuzz [iterations]
+ *
+ * With libFuzzer, the fuzzer provides the inputs instead:
+ *
+ *  clang -g -O1 -fsanitize=fuzzer,address -DINH_STRING_LIBFUZZER inh_string_fuzz.c
+ */
+
+#define INH_STRING_IMPLEMENTATION
+#include "../inh_string.h"
+
+#include <time.h>
+
+#define CHECK(_cond) \
+    do { \
+	if (!(_cond)) { \
+	    fprintf(stderr, "%s:%d: mismatch: %s\n", __FILE__, __LINE__, #_cond); \
+	    abort(); \
+	} \
+    } while (0)
+
+/*
+ * Reference versions, written as plain loops over the characters.
+ */
+
+size_t ref_copy_from (INH_string * dest, const INH_string * source, size_t start) {
+    size_t len = (dest->len < source->len) ? dest->len : source->len;
+    size_t i;
+    for (i = start; i < start + len; i++) {
+	dest->buffer[i - start] = source->buffer[i];
+    }
+    return len;
+}
+
+size_t ref_write_stream_term (const INH_string * string, char * stream) {
+    size_t i;
+    for (i = 0; (i < string->len) && string->buffer[i] != '\0'; i++) {
+	stream[i] = string->buffer[i];
+    }
+    stream[i] = '\0';
+    return i;
+}
+
+bool ref_equal_sub (const INH_string * str1, const INH_string * str2, size_t start, size_t end) {
+    // Note: like str_equal_sub, this compares from the start of both strings
+    size_t sub_len = end - start;
+    if (sub_len > str1->len || sub_len > str2->len) {
+	return false;
+    }
+    size_t i;
+    for (i = 0; i < sub_len; i++) {
+	if (str1->buffer[i] != str2->buffer[i]) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+int ref_compare (const INH_string * str1, const INH_string * str2) {
+    size_t i;
+    for (i = 0; i < str1->len && i < str2->len; i++) {
+	unsigned char c1 = str1->buffer[i];
+	unsigned char c2 = str2->buffer[i];
+	if (c1 != c2) {
+	    return (c1 < c2) ? -1 : 1;
+	}
+    }
+    return (str1->len > str2->len) - (str1->len < str2->len);
+}
+
+INH_string * ref_join (INH_string * sep, size_t len, INH_string * strings[]) {
+    size_t total = 0;
+    size_t i, j;
+    for (i = 0; i < len; i++) {
+	total += strings[i]->len + ((i > 0) ? sep->len : 0);
+    }
+    INH_string * new = str_alloc(total);
+    size_t at = 0;
+    for (i = 0; i < len; i++) {
+	if (i > 0) {
+	    for (j = 0; j < sep->len; j++) {
+		new->buffer[at++] = sep->buffer[j];
+	    }
+	}
+	for (j = 0; j < strings[i]->len; j++) {
+	    new->buffer[at++] = strings[i]->buffer[j];
+	}
+    }
+    return new;
+}
+
+INH_string * ref_flip_case (const INH_string * string, char lo) {
+    INH_string * new = str_alloc(string->len);
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+	char c = string->buffer[i];
+	new->buffer[i] = (c >= lo && c <= lo + 25) ? (char)(c ^ 0x20) : c;
+    }
+    return new;
+}
+
+void ref_flip_case_in_place (INH_string * string, char lo) {
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+	char c = string->buffer[i];
+	string->buffer[i] = (c >= lo && c <= lo + 25) ? (char)(c ^ 0x20) : c;
+    }
+}
+
+INH_string * ref_replace_char (const INH_string * string, char from, char to) {
+    INH_string * new = str_alloc(string->len);
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+	new->buffer[i] = (string->buffer[i] == from) ? to : string->buffer[i];
+    }
+    return new;
+}
+
+void ref_replace_char_in_place (INH_string * string, char from, char to) {
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+	if (string->buffer[i] == from) {
+	    string->buffer[i] = to;
+	}
+    }
+}
+
+void ref_translate_in_place (INH_string * string, const unsigned char table[256]) {
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+	string->buffer[i] = table[(unsigned char)string->buffer[i]];
+    }
+}
+
+INH_string * ref_filter_new (const INH_string * string, const bool keep[256]) {
+    INH_string * new = str_new_len("", 0);
+    size_t i;
+    for (i = 0; i < string->len; i++) {
+	if (keep[(unsigned char)string->buffer[i]]) {
+	    new = str_append(new, string->buffer[i]);
+	}
+    }
+    return new;
+}
+
+bool ref_is_space (char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+INH_string * ref_trim_new (const INH_string * string) {
+    size_t start = 0, end = string->len;
+    while (start < end && ref_is_space(string->buffer[start])) {
+	start++;
+    }
+    while (end > start && ref_is_space(string->buffer[end - 1])) {
+	end--;
+    }
+    INH_string * new = str_alloc(end - start);
+    size_t i;
+    for (i = start; i < end; i++) {
+	new->buffer[i - start] = string->buffer[i];
+    }
+    return new;
+}
+
+size_t ref_mismatch (const char * p1, const char * p2, size_t len) {
+    size_t i;
+    for (i = 0; i < len && p1[i] == p2[i]; i++) {
+    }
+    return i;
+}
+
+void ref_flip_case_bytes (char * dest, const char * src, size_t len, char lo) {
+    size_t i;
+    for (i = 0; i < len; i++) {
+	char c = src[i];
+	dest[i] = (c >= lo && c <= lo + 25) ? (char)(c ^ 0x20) : c;
+    }
+}
+
+void ref_replace_char_bytes (char * dest, const char * src, size_t len, char from, char to) {
+    size_t i;
+    for (i = 0; i < len; i++) {
+	dest[i] = (src[i] == from) ? to : src[i];
+    }
+}
+
+size_t ref_filter_bytes (char * dest, const char * src, size_t len, const bool keep[256]) {
+    size_t i, j = 0;
+    for (i = 0; i < len; i++) {
+	if (keep[(unsigned char)src[i]]) {
+	    dest[j++] = src[i];
+	}
+    }
+    return j;
+}
+
+INH_string * ref_json (INH_view view) {
+    INH_string * new = str_new("\"");
+    size_t i;
+    for (i = 0; i < view.len; i++) {
+	unsigned char c = view.data[i];
+	char escape[8];
+	if (c == '"' || c == '\\') {
+	    new = str_append(new, '\\');
+	    new = str_append(new, c);
+	} else if (c < 0x20) {
+	    switch (c) {
+		case '\b': strcpy(escape, "\\b"); break;
+		case '\f': strcpy(escape, "\\f"); break;
+		case '\n': strcpy(escape, "\\n"); break;
+		case '\r': strcpy(escape, "\\r"); break;
+		case '\t': strcpy(escape, "\\t"); break;
+		default: snprintf(escape, sizeof(escape), "\\u%04x", c); break;
+	    }
+	    INH_string * piece = str_new(escape);
+	    str_cat(&new, piece);
+	    free(piece);
+	} else {
+	    new = str_append(new, c);
+	}
+    }
+    return str_append(new, '"');
+}
+
+INH_string * ref_csv (INH_view view, char sep) {
+    bool quote = false;
+    size_t i;
+    for (i = 0; i < view.len; i++) {
+	char c = view.data[i];
+	quote = quote || c == sep || c == '"' || c == '\r' || c == '\n';
+    }
+    INH_string * new = str_new_len(quote ? "\"" : "", quote ? 1 : 0);
+    for (i = 0; i < view.len; i++) {
+	new = str_append(new, view.data[i]);
+	if (view.data[i] == '"') {
+	    new = str_append(new, '"');
+	}
+    }
+    return quote ? str_append(new, '"') : new;
+}
+
+/*
+ * Small fixed-size unsigned big integer, just large enough for formatting a
+ * double exactly, for the reference version of str__shortest_digits.
+ */
+#define REF_BIG_WORDS 40
+
+typedef struct ref_big {
+    size_t len;
+    uint32_t words[REF_BIG_WORDS];
+} ref_big;
+
+void ref_big_trim (ref_big * a) {
+    while (a->len > 0 && a->words[a->len - 1] == 0) {
+	a->len--;
+    }
+}
+
+void ref_big_set (ref_big * a, uint64_t value) {
+    a->len = 0;
+    while (value) {
+	a->words[a->len++] = (uint32_t)value;
+	value >>= 32;
+    }
+}
+
+void ref_big_mul_small (ref_big * a, uint32_t factor) {
+    uint64_t carry = 0;
+    size_t i;
+    for (i = 0; i < a->len; i++) {
+	uint64_t t = (uint64_t)a->words[i] * factor + carry;
+	a->words[i] = (uint32_t)t;
+	carry = t >> 32;
+    }
+    if (carry) {
+	assert(a->len < REF_BIG_WORDS);
+	a->words[a->len++] = (uint32_t)carry;
+    }
+}
+
+void ref_big_mul_pow10 (ref_big * a, int n) {
+    static const uint32_t small_pow10[9] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    };
+    for (; n >= 9; n -= 9) {
+	ref_big_mul_small(a, 1000000000);
+    }
+    if (n > 0) {
+	ref_big_mul_small(a, small_pow10[n]);
+    }
+}
+
+void ref_big_shl (ref_big * a, int bits) {
+    ref_big t = *a;
+    size_t words = bits / 32;
+    int shift = bits % 32;
+    size_t i;
+    assert(t.len + words + 1 <= REF_BIG_WORDS);
+    memset(a->words, 0, sizeof(a->words));
+    for (i = 0; i < t.len; i++) {
+	a->words[i + words] |= t.words[i] << shift;
+	if (shift) {
+	    a->words[i + words + 1] |= t.words[i] >> (32 - shift);
+	}
+    }
+    a->len = t.len ? t.len + words + 1 : 0;
+    ref_big_trim(a);
+}
+
+int ref_big_cmp (const ref_big * a, const ref_big * b) {
+    if (a->len != b->len) {
+	return (a->len < b->len) ? -1 : 1;
+    }
+    size_t i;
+    for (i = a->len; i-- > 0;) {
+	if (a->words[i] != b->words[i]) {
+	    return (a->words[i] < b->words[i]) ? -1 : 1;
+	}
+    }
+    return 0;
+}
+
+/*
+ * out = a + b
+ * out may be the same as a or b.
+ */
+void ref_big_add (ref_big * out, const ref_big * a, const ref_big * b) {
+    size_t len = (a->len > b->len) ? a->len : b->len;
+    uint64_t carry = 0;
+    size_t i;
+    for (i = 0; i < len; i++) {
+	uint64_t t = carry;
+	t += (i < a->len) ? a->words[i] : 0;
+	t += (i < b->len) ? b->words[i] : 0;
+	out->words[i] = (uint32_t)t;
+	carry = t >> 32;
+    }
+    out->len = len;
+    if (carry) {
+	assert(out->len < REF_BIG_WORDS);
+	out->words[out->len++] = (uint32_t)carry;
+    }
+}
+
+/*
+ * a = a - b, where a >= b
+ */
+void ref_big_sub (ref_big * a, const ref_big * b) {
+    uint64_t borrow = 0;
+    size_t i;
+    for (i = 0; i < a->len; i++) {
+	uint64_t t = (uint64_t)a->words[i] - ((i < b->len) ? b->words[i] : 0) - borrow;
+	a->words[i] = (uint32_t)t;
+	borrow = t >> 63;
+    }
+    ref_big_trim(a);
+}
+
+/*
+ * Generate the shortest digits that read back as the given positive, finite
+ * value, using Burger and Dybvig's free-format algorithm with exact integer
+ * arithmetic.
+ * The value is 0.d1d2d3... * 10^(*point).
+ * Returns the number of digits written.
+ */
+int ref_shortest_digits (double value, char digits[17], int * point) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t f = bits & ((1ull << 52) - 1);
+    int biased_e = (int)((bits >> 52) & 0x7ff);
+    int e;
+    if (biased_e == 0) {
+	e = -1074;
+    } else {
+	f |= 1ull << 52;
+	e = biased_e - 1075;
+    }
+    // Boundaries that round to the value also read back as it when f is even
+    bool even = (f & 1) == 0;
+    // At a power of two the gap to the next lower value is half as big
+    bool unequal_gaps = (f == (1ull << 52)) && biased_e > 1;
+
+    // value = r / s, with the rounding boundaries at (r - mm) / s and (r + mp) / s
+    ref_big r, s, mp, mm, t;
+    ref_big_set(&r, f);
+    ref_big_set(&s, 1);
+    ref_big_set(&mp, 1);
+    ref_big_set(&mm, 1);
+    if (e >= 0) {
+	ref_big_shl(&r, e + (unequal_gaps ? 2 : 1));
+	ref_big_shl(&s, unequal_gaps ? 2 : 1);
+	ref_big_shl(&mp, e + (unequal_gaps ? 1 : 0));
+	ref_big_shl(&mm, e);
+    } else {
+	ref_big_shl(&r, unequal_gaps ? 2 : 1);
+	ref_big_shl(&s, (unequal_gaps ? 2 : 1) - e);
+	ref_big_shl(&mp, unequal_gaps ? 1 : 0);
+    }
+
+    // Estimate k = ceil(log10(value)) from the binary exponent, which is
+    // either exact or one too low
+    int log2_value = e;
+    uint64_t tmp;
+    for (tmp = f >> 1; tmp; tmp >>= 1) {
+	log2_value++;
+    }
+    int k;
+    if (log2_value > 0) {
+	k = ((log2_value * 78913) >> 18) + 1;
+    } else if (log2_value == 0) {
+	k = 0;
+    } else {
+	k = -((-log2_value * 78913) >> 18);
+    }
+    if (k >= 0) {
+	ref_big_mul_pow10(&s, k);
+    } else {
+	ref_big_mul_pow10(&r, -k);
+	ref_big_mul_pow10(&mp, -k);
+	ref_big_mul_pow10(&mm, -k);
+    }
+    ref_big_add(&t, &r, &mp);
+    int high = ref_big_cmp(&t, &s);
+    if (even ? high >= 0 : high > 0) {
+	k++;
+	ref_big_mul_small(&s, 10);
+    }
+    *point = k;
+
+    int n = 0;
+    for (;;) {
+	ref_big_mul_small(&r, 10);
+	ref_big_mul_small(&mp, 10);
+	ref_big_mul_small(&mm, 10);
+	int digit = 0;
+	while (ref_big_cmp(&r, &s) >= 0) {
+	    ref_big_sub(&r, &s);
+	    digit++;
+	}
+	int low = ref_big_cmp(&r, &mm);
+	bool low_done = even ? low <= 0 : low < 0;
+	ref_big_add(&t, &r, &mp);
+	high = ref_big_cmp(&t, &s);
+	bool high_done = even ? high >= 0 : high > 0;
+	if (!low_done && !high_done) {
+	    digits[n++] = (char)('0' + digit);
+	    continue;
+	}
+	if (low_done && high_done) {
+	    // Both ends are in range, so round to the nearest, ties to even
+	    t = r;
+	    ref_big_shl(&t, 1);
+	    int half = ref_big_cmp(&t, &s);
+	    if (half > 0 || (half == 0 && (digit & 1))) {
+		digit++;
+	    }
+	} else if (high_done) {
+	    digit++;
+	}
+	digits[n++] = (char)('0' + digit);
+	return n;
+    }
+}
+
+/*
+ * Compare the fast routines to the reference ones on one input.
+ * The first 4 bytes choose the parameters, and the rest is split into two
+ * strings.
+ */
+void check_input (const unsigned char * data, size_t size) {
+    if (size < 4) {
+	return;
+    }
+    unsigned char p0 = data[0], p1 = data[1], p2 = data[2], p3 = data[3];
+    const char * rest = (const char *)data + 4;
+    size_t rest_len = size - 4;
+    size_t split = p0 % (rest_len + 1);
+    INH_string * s1 = str_new_len(rest, split);
+    INH_string * s2 = str_new_len(rest + split, rest_len - split);
+    INH_string * fast;
+    INH_string * ref;
+
+    // Copying from an offset, into a destination of any length
+    INH_string * dest_fast = str_alloc(p1 % (s1->len + 1));
+    INH_string * dest_ref = str_alloc(dest_fast->len);
+    size_t copy_len = (dest_fast->len < s1->len) ? dest_fast->len : s1->len;
+    size_t start = p2 % (s1->len - copy_len + 1);
+    CHECK(str_copy_from(dest_fast, s1, start) == ref_copy_from(dest_ref, s1, start));
+    CHECK(memcmp(dest_fast->buffer, dest_ref->buffer, copy_len) == 0);
+    free(dest_fast);
+    free(dest_ref);
+
+    // Null-terminated output stops at an embedded null character
+    char * out_fast = malloc(s1->len + 1);
+    char * out_ref = malloc(s1->len + 1);
+    size_t out_len = str_write_stream_term(s1, out_fast);
+    CHECK(out_len == ref_write_stream_term(s1, out_ref));
+    CHECK(memcmp(out_fast, out_ref, out_len + 1) == 0);
+    free(out_fast);
+    free(out_ref);
+
+    // Equality and order, including against a copy with one byte changed
+    size_t sub_start = p1 % 8;
+    size_t sub_end = sub_start + p2 % (rest_len + 2);
+    CHECK(str_equal_sub(s1, s2, sub_start, sub_end) == ref_equal_sub(s1, s2, sub_start, sub_end));
+    CHECK(str_notequal_sub(s1, s2, sub_start, sub_end) == !ref_equal_sub(s1, s2, sub_start, sub_end));
+    CHECK(str_equal(s1, s2) == (ref_compare(s1, s2) == 0));
+    CHECK(str_compare(s1, s2) == ref_compare(s1, s2));
+    INH_string * changed = str_dup(s1);
+    if (changed->len > 0) {
+	changed->buffer[p3 % changed->len] ^= (char)(p1 | 1);
+    }
+    CHECK(str_compare(s1, changed) == ref_compare(s1, changed));
+    CHECK(str_equal_sub(s1, changed, 0, s1->len) == (ref_compare(s1, changed) == 0));
+    free(changed);
+
+    // Joining pieces of s2 with s1 as the separator
+    INH_string * pieces[4];
+    size_t piece_count = p3 % 5;
+    size_t i;
+    for (i = 0; i < piece_count; i++) {
+	size_t piece_start = s2->len * i / piece_count;
+	size_t piece_end = s2->len * (i + 1) / piece_count;
+	pieces[i] = str_new_sub(s2, piece_start, piece_end);
+    }
+    if (piece_count > 0) {
+	fast = str_join(s1, piece_count, pieces);
+	ref = ref_join(s1, piece_count, pieces);
+	CHECK(str_equal(fast, ref));
+	free(fast);
+	free(ref);
+    }
+    for (i = 0; i < piece_count; i++) {
+	free(pieces[i]);
+    }
+
+    fast = str_new_cat(s1, s2);
+    CHECK(fast->len == s1->len + s2->len);
+    CHECK(memcmp(fast->buffer, s1->buffer, s1->len) == 0);
+    CHECK(memcmp(fast->buffer + s1->len, s2->buffer, s2->len) == 0);
+    free(fast);
+
+    // Transforms of the second part, from byte shift on
+    size_t shift = p1 % (s2->len + 1);
+    INH_string * shifted = str_new_sub(s2, shift, s2->len);
+    fast = str_to_lower_new(shifted);
+    ref = ref_flip_case(shifted, 'A');
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    fast = str_to_upper_new(shifted);
+    ref = ref_flip_case(shifted, 'a');
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    fast = str_replace_char_new(shifted, (char)p2, (char)p3);
+    ref = ref_replace_char(shifted, (char)p2, (char)p3);
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    fast = str_trim_new(shifted);
+    ref = ref_trim_new(shifted);
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    unsigned char table[256];
+    bool keep[256];
+    for (i = 0; i < 256; i++) {
+	table[i] = (unsigned char)(i * p2 + p3);
+	keep[i] = ((i ^ p3) & 3) != 0;
+    }
+    fast = str_translate(str_dup(shifted), table);
+    ref = str_dup(shifted);
+    ref_translate_in_place(ref, table);
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    fast = str_filter_new(shifted, keep);
+    ref = ref_filter_new(shifted, keep);
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+
+    // The kernels, called directly on data at 16 alignments past malloc's.
+    // Sources and destinations are misaligned by different amounts, and
+    // in-place calls use the same buffer for both.
+    char * src_block = malloc(rest_len + 16);
+    char * dest_block = malloc(rest_len + 16);
+    char * ref_block = malloc(rest_len + 16);
+    size_t k;
+    for (k = 0; k < 16; k++) {
+	char * src = src_block + k;
+	char * dest = dest_block + (k * 5 + p0) % 16;
+	char * expect = ref_block + (k * 3) % 16;
+	memcpy(src, rest, rest_len);
+
+	str__flip_case(dest, src, rest_len, 'A');
+	ref_flip_case_bytes(expect, src, rest_len, 'A');
+	CHECK(memcmp(dest, expect, rest_len) == 0);
+	str__replace_char(dest, src, rest_len, (char)p2, (char)p3);
+	ref_replace_char_bytes(expect, src, rest_len, (char)p2, (char)p3);
+	CHECK(memcmp(dest, expect, rest_len) == 0);
+	size_t kept = str__filter(dest, src, rest_len, keep);
+	CHECK(kept == ref_filter_bytes(expect, src, rest_len, keep));
+	CHECK(memcmp(dest, expect, kept) == 0);
+
+	// Equal runs of any length, then one changed byte
+	memcpy(dest, src, rest_len);
+	size_t len = p2 % (rest_len + 1);
+	CHECK(str__mismatch(src, dest, len) == len);
+	if (rest_len > 0) {
+	    dest[p3 % rest_len] ^= (char)(p1 | 1);
+	}
+	CHECK(str__mismatch(src, dest, rest_len) == ref_mismatch(src, dest, rest_len));
+	CHECK(str__mismatch(dest, src, len) == ref_mismatch(dest, src, len));
+
+	ref_flip_case_bytes(expect, src, rest_len, 'a');
+	str__flip_case(src, src, rest_len, 'a');
+	CHECK(memcmp(src, expect, rest_len) == 0);
+	kept = ref_filter_bytes(expect, src, rest_len, keep);
+	CHECK(str__filter(src, src, rest_len, keep) == kept);
+	CHECK(memcmp(src, expect, kept) == 0);
+    }
+    free(src_block);
+    free(dest_block);
+    free(ref_block);
+
+    // Escaping
+    INH_view view = { s2->buffer + shift, s2->len - shift };
+    INH_string_builder builder;
+    str_builder_init(&builder, 0);
+    str_builder_append_json(&builder, view);
+    fast = str_builder_finish(&builder);
+    ref = ref_json(view);
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    str_builder_init(&builder, 0);
+    str_builder_append_csv(&builder, view, (char)p2);
+    fast = str_builder_finish(&builder);
+    ref = ref_csv(view, (char)p2);
+    CHECK(str_equal(fast, ref));
+    free(fast);
+    free(ref);
+    free(shifted);
+
+    // Doubles read back exactly
+    if (rest_len >= 8) {
+	double d;
+	memcpy(&d, rest, sizeof(d));
+	if (d == d) {
+	    fast = str_append_double(str_new(""), d);
+	    double parsed;
+	    CHECK(str_parse_double(str_view(fast), &parsed) == fast->len);
+	    CHECK(parsed == d);
+	    free(fast);
+	}
+	d = fabs(d);
+	if (d > 0 && d < INFINITY) {
+	    char fast_digits[17], ref_digits[17];
+	    int fast_point, ref_point;
+	    int n = str__shortest_digits(d, fast_digits, &fast_point);
+	    CHECK(n == ref_shortest_digits(d, ref_digits, &ref_point));
+	    CHECK(fast_point == ref_point);
+	    CHECK(memcmp(fast_digits, ref_digits, n) == 0);
+	}
+    }
+
+    free(s1);
+    free(s2);
+}
+
+#ifdef INH_STRING_LIBFUZZER
+
+int LLVMFuzzerTestOneInput (const uint8_t * data, size_t size) {
+    check_input(data, size);
+    return 0;
+}
+
+#else
+
+double seconds (void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*
+ * Frees a result and returns its length. Benchmarks call it through a
+ * volatile pointer, so that the compiler can't see that the result is never
+ * read and skip making it.
+ */
+size_t free_result (INH_string * string) {
+    size_t len = string->len;
+    free(string);
+    return len;
+}
+
+size_t (* volatile use_result) (INH_string * string) = free_result;
+
+/*
+ * Time calls of a fast routine and of its reference version, and print the
+ * nanoseconds per call in a row labelled by column.
+ */
+#define BENCHMARK(_name, _fast, _ref) \
+    do { \
+	size_t n; \
+	double start = seconds(); \
+	for (n = 0; n < calls; n++) { \
+	    _fast; \
+	} \
+	double fast_time = seconds() - start; \
+	start = seconds(); \
+	for (n = 0; n < calls; n++) { \
+	    _ref; \
+	} \
+	double ref_time = seconds() - start; \
+	printf("%8s %-18s %12.1f %12.1f\n", column, _name, fast_time * 1e9 / calls, ref_time * 1e9 / calls); \
+    } while (0)
+
+/*
+ * Time the fast and reference versions of some routines, for several input
+ * sizes. The in-place transforms are timed on their own, and the others
+ * include allocating the result.
+ */
+void benchmark (void) {
+    size_t sizes[] = { 8, 64, 512, 4096, 65536 };
+    size_t s;
+    unsigned char next_letter[256];
+    bool keep[256];
+    size_t i;
+    for (i = 0; i < 256; i++) {
+	next_letter[i] = (unsigned char)((i >= 'a' && i < 'z') ? i + 1 : (i == 'z') ? 'a' : i);
+	// Keeps about half the letters, in no pattern a branch predictor can follow
+	keep[i] = ((i * 167) >> 3) & 1;
+    }
+    printf("%8s %-18s %12s %12s\n", "size", "routine", "fast ns", "reference ns");
+    for (s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+	size_t size = sizes[s];
+	char column[16];
+	snprintf(column, sizeof(column), "%zu", size);
+	size_t calls = (64u << 20) / size;
+	INH_string * a = str_alloc(size);
+	INH_string * b = str_alloc(size);
+	for (i = 0; i < size; i++) {
+	    a->buffer[i] = b->buffer[i] = (char)('A' + i % 50);
+	}
+	INH_string * c = str_dup(a);
+	INH_string * padded = str_dup(a);
+	for (i = 0; i < size && i < 3; i++) {
+	    padded->buffer[i] = ' ';
+	    padded->buffer[size - 1 - i] = '\n';
+	}
+	volatile size_t sink = 0;
+
+	BENCHMARK("str_copy_from", sink += str_copy_from(b, a, 0), sink += ref_copy_from(b, a, 0));
+	BENCHMARK("str_equal_sub", sink += str_equal_sub(a, b, 0, size), sink += ref_equal_sub(a, b, 0, size));
+	BENCHMARK("str_compare", sink += str_compare(a, b), sink += ref_compare(a, b));
+	BENCHMARK("str_to_lower", str_to_lower(c), ref_flip_case_in_place(c, 'A'));
+	BENCHMARK("str_replace_char",
+		str_replace_char(c, (n & 1) ? 'x' : 'y', (n & 1) ? 'y' : 'x'),
+		ref_replace_char_in_place(c, (n & 1) ? 'x' : 'y', (n & 1) ? 'y' : 'x'));
+	BENCHMARK("str_translate", str_translate(c, next_letter), ref_translate_in_place(c, next_letter));
+	sink += c->buffer[0];
+
+	// These allocate, so time fewer calls
+	calls /= 4;
+	BENCHMARK("str_to_lower_new", sink += use_result(str_to_lower_new(a)), sink += use_result(ref_flip_case(a, 'A')));
+	BENCHMARK("str_trim_new", sink += use_result(str_trim_new(padded)), sink += use_result(ref_trim_new(padded)));
+	// The reference appends one byte at a time, so time it on fewer calls still
+	calls /= 4;
+	BENCHMARK("str_filter_new", sink += use_result(str_filter_new(a, keep)), sink += use_result(ref_filter_new(a, keep)));
+
+	free(a);
+	free(b);
+	free(c);
+	free(padded);
+    }
+
+    // Doubles: str_append_double, formatting into the same string over and
+    // over, against snprintf's 17 digits, which also read back exactly but
+    // aren't shortest, and the digit generation against the bignum reference
+    const char * ranges[] = { "[0,1000]", "~1e-200", "any" };
+    double values[1024];
+    char buf[32];
+    INH_string * out = str_alloc(32);
+    printf("\n%8s %-18s %12s %12s\n", "range", "routine", "fast ns", "reference ns");
+    for (s = 0; s < sizeof(ranges) / sizeof(*ranges); s++) {
+	for (i = 0; i < 1024; i++) {
+	    double unit = (double)rand() / RAND_MAX;
+	    if (s == 0) {
+		values[i] = unit * 1000;
+	    } else if (s == 1) {
+		values[i] = (1 + unit) * 1e-200;
+	    } else {
+		do {
+		    uint64_t bits = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+		    bits &= 0x7fffffffffffffffull;
+		    memcpy(&values[i], &bits, sizeof(values[i]));
+		} while (!(values[i] < INFINITY));
+	    }
+	}
+	const char * column = ranges[s];
+	size_t calls = 1u << 20;
+	volatile size_t sink = 0;
+	char digits[17];
+	int point;
+	BENCHMARK("str_append_double",
+		(out->len = 0, out = str_append_double(out, values[n & 1023]), sink += out->len),
+		sink += snprintf(buf, sizeof(buf), "%.17g", values[n & 1023]));
+	BENCHMARK("shortest_digits",
+		sink += str__shortest_digits(values[n & 1023], digits, &point),
+		sink += ref_shortest_digits(values[n & 1023], digits, &point));
+    }
+    free(out);
+}
+
+int main (int argc, char * argv[]) {
+    long iterations = (argc > 1) ? atol(argv[1]) : 100000;
+    unsigned char data[300];
+    long n;
+    srand(1);
+    for (n = 0; n < iterations; n++) {
+	size_t size = rand() % sizeof(data);
+	size_t i;
+	// Mostly letters, with some of the bytes that routines treat specially
+	for (i = 0; i < size; i++) {
+	    int r = rand() % 16;
+	    data[i] = (r == 0) ? '\0' : (r == 1) ? '"' : (r == 2) ? '\\' : (r == 3) ? '\n' : (r == 4) ? (unsigned char)rand() : (unsigned char)('A' + rand() % 58);
+	}
+	check_input(data, size);
+    }
+    printf("%ld inputs matched the reference versions\n\n", iterations);
+    benchmark();
+    return 0;
+}
+
+#endif
@@ -1,3 +1,14 @@
+/*
+ * Some of these tests only run with optional features turned on, so build
+ * and run them both ways:
+ *
+ *  cc inh_string_test.c -o inh_string_test -lm && ./inh_string_test
+ *  cc -DINH_STRING_REFCOUNT -DINH_STRING_THREADS inh_string_test.c -o inh_string_test -lm -pthread && ./inh_string_test
+ */
+
+// For fileno
+#define _POSIX_C_SOURCE 200809L
+
 #define INH_STRING_IMPLEMENTATION
 #include "../inh_string.h"
 
@@ -214,6 +225,687 @@ void test_join (void) {
 
 }
 
+void test_str_case (void) {
+    // long enough to use the vector loop and the leftover loop
+    INH_string * s1 = str_new("Hello, World! @[`{ 0123 The Quick Brown FOX");
+    INH_string * lower = str_new("hello, world! @[`{ 0123 the quick brown fox");
+    INH_string * upper = str_new("HELLO, WORLD! @[`{ 0123 THE QUICK BROWN FOX");
+
+    INH_string * s2 = str_to_lower_new(s1);
+    assert(str_equal(s2, lower));
+    INH_string * s3 = str_to_upper_new(s1);
+    assert(str_equal(s3, upper));
+
+    str_to_upper(s2);
+    assert(str_equal(s2, upper));
+    str_to_lower(s3);
+    assert(str_equal(s3, lower));
+
+    free(s1);
+    free(s2);
+    free(s3);
+    free(lower);
+    free(upper);
+}
+
+void test_str_trim (void) {
+    INH_string * s1 = str_new(" \t\r\n trim me \v\f ");
+    INH_string * expected = str_new("trim me");
+    INH_string * s2 = str_trim_new(s1);
+    assert(str_equal(s2, expected));
+    s1 = str_trim(s1);
+    assert(str_equal(s1, expected));
+
+    // nothing to trim, and only whitespace
+    s1 = str_trim(s1);
+    assert(str_equal(s1, expected));
+    INH_string * s3 = str_new("    ");
+    s3 = str_trim(s3);
+    assert(s3->len == 0);
+
+    free(s1);
+    free(s2);
+    free(s3);
+    free(expected);
+}
+
+void test_str_replace_char (void) {
+    INH_string * s1 = str_new("a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q");
+    INH_string * expected = str_new("a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q");
+    INH_string * s2 = str_replace_char_new(s1, '/', '.');
+    assert(str_equal(s2, expected));
+    str_replace_char(s1, '/', '.');
+    assert(str_equal(s1, expected));
+
+    free(s1);
+    free(s2);
+    free(expected);
+}
+
+void test_str_translate (void) {
+    // rot13 as a translation table
+    unsigned char rot13[256];
+    int i;
+    for (i = 0; i < 256; i++) {
+	rot13[i] = i;
+    }
+    for (i = 0; i < 26; i++) {
+	rot13['a' + i] = 'a' + (i + 13) % 26;
+	rot13['A' + i] = 'A' + (i + 13) % 26;
+    }
+    INH_string * s1 = str_new("Hello");
+    INH_string * expected = str_new("Uryyb");
+    INH_string * s2 = str_translate_new(s1, rot13);
+    assert(str_equal(s2, expected));
+    str_translate(s2, rot13);
+    assert(str_equal(s2, s1));
+
+    // strip control characters
+    bool printable[256];
+    for (i = 0; i < 256; i++) {
+	printable[i] = (i >= 32 && i < 127);
+    }
+    INH_string * s3 = str_new("\ttab\x01 and\r\n bell\a");
+    INH_string * stripped = str_new("tab and bell");
+    INH_string * s4 = str_filter_new(s3, printable);
+    assert(str_equal(s4, stripped));
+    s3 = str_filter(s3, printable);
+    assert(str_equal(s3, stripped));
+
+    free(s1);
+    free(s2);
+    free(s3);
+    free(s4);
+    free(expected);
+    free(stripped);
+}
+
+void test_str_append_number (void) {
+    INH_string * s1 = str_new("");
+    s1 = str_append_int(s1, 0);
+    s1 = str_append(s1, ' ');
+    s1 = str_append_int(s1, -1234567);
+    s1 = str_append(s1, ' ');
+    s1 = str_append_int(s1, INT64_MIN);
+    s1 = str_append(s1, ' ');
+    s1 = str_append_u64(s1, UINT64_MAX);
+    INH_string * expected = str_new("0 -1234567 -9223372036854775808 18446744073709551615");
+    assert(str_equal(s1, expected));
+    free(s1);
+    free(expected);
+
+    // doubles, and the shortest strings that read back as them
+    double doubles[] = {
+	0.0, -0.0, 1.5, -2.25, 100.0, 0.1, 0.1 + 0.2, 123.456, 1e21, 1e-7, 0.000001,
+	5e-324, 1.7976931348623157e308, 9007199254740993.0, 2.2250738585072014e-308,
+    };
+    char * cstrings[] = {
+	"0", "-0", "1.5", "-2.25", "100", "0.1", "0.30000000000000004", "123.456", "1e+21", "1e-7", "0.000001",
+	"5e-324", "1.7976931348623157e+308", "9007199254740992", "2.2250738585072014e-308",
+    };
+    size_t length = sizeof(doubles) / sizeof(*doubles);
+    size_t i;
+    for (i = 0; i < length; i++) {
+	INH_string * s = str_append_double(str_new(""), doubles[i]);
+	char * c = str_convert(s);
+	assert(strcmp(c, cstrings[i]) == 0);
+	free(c);
+	free(s);
+    }
+
+    // random bit patterns read back exactly, and are no longer than %.17g
+    srand(1);
+    for (i = 0; i < 100000; i++) {
+	uint64_t bits = ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+	double d;
+	memcpy(&d, &bits, sizeof(d));
+	if (d != d || d == INFINITY || d == -INFINITY) {
+	    continue;
+	}
+	INH_string * s = str_append_double(str_new(""), d);
+	char * c = str_convert(s);
+	assert(strtod(c, NULL) == d);
+	double parsed;
+	assert(str_parse_double(str_view(s), &parsed) == s->len);
+	assert(parsed == d);
+	char shortest[32];
+	int precision;
+	for (precision = 1; precision <= 17; precision++) {
+	    snprintf(shortest, sizeof(shortest), "%.*e", precision - 1, d);
+	    if (strtod(shortest, NULL) == d) {
+		break;
+	    }
+	}
+	// count significant digits, without leading zeros or the zeros of an integer
+	char significant[32];
+	size_t digits = 0;
+	size_t j;
+	for (j = 0; c[j] != '\0' && c[j] != 'e'; j++) {
+	    if (c[j] >= '0' && c[j] <= '9' && (digits > 0 || c[j] != '0')) {
+		significant[digits++] = c[j];
+	    }
+	}
+	while (strchr(c, '.') == NULL && digits > 0 && significant[digits - 1] == '0') {
+	    digits--;
+	}
+	assert(digits == (size_t)precision);
+	free(c);
+	free(s);
+    }
+}
+
+void test_str_parse_number (void) {
+    uint64_t u;
+    int64_t n;
+    double d;
+
+    assert(str_parse_u64(str_view_cstr("18446744073709551615"), &u) == 20);
+    assert(u == UINT64_MAX);
+    assert(str_parse_u64(str_view_cstr("18446744073709551616"), &u) == 0);
+    assert(str_parse_u64(str_view_cstr("42abc"), &u) == 2);
+    assert(u == 42);
+    assert(str_parse_u64(str_view_cstr("abc"), &u) == 0);
+
+    assert(str_parse_int(str_view_cstr("-9223372036854775808"), &n) == 20);
+    assert(n == INT64_MIN);
+    assert(str_parse_int(str_view_cstr("9223372036854775808"), &n) == 0);
+    assert(str_parse_int(str_view_cstr("+17,"), &n) == 3);
+    assert(n == 17);
+    assert(str_parse_int(str_view_cstr("-"), &n) == 0);
+
+    // parse only the viewed part of a String
+    INH_string * s1 = str_new("x=12345");
+    assert(str_parse_int(str_view_sub(s1, 2, 5), &n) == 3);
+    assert(n == 123);
+    free(s1);
+
+    assert(str_parse_double(str_view_cstr("-12.5e3 "), &d) == 7);
+    assert(d == -12500.0);
+    assert(str_parse_double(str_view_cstr(".25"), &d) == 3);
+    assert(d == 0.25);
+    assert(str_parse_double(str_view_cstr("3.e"), &d) == 2);
+    assert(d == 3.0);
+    assert(str_parse_double(str_view_cstr("0.1"), &d) == 3);
+    assert(d == 0.1);
+    assert(str_parse_double(str_view_cstr("123456789012345678901234567890"), &d) == 30);
+    assert(d == 123456789012345678901234567890.0);
+    assert(str_parse_double(str_view_cstr("1e-400"), &d) == 6);
+    assert(d == 0.0);
+    assert(str_parse_double(str_view_cstr("-Infinity"), &d) == 9);
+    assert(d == -INFINITY);
+    assert(str_parse_double(str_view_cstr("nan"), &d) == 3);
+    assert(d != d);
+    assert(str_parse_double(str_view_cstr("."), &d) == 0);
+    assert(str_parse_double(str_view_cstr("e5"), &d) == 0);
+}
+
+void test_str_retain (void) {
+    INH_string * s1 = str_new("shared payload");
+    INH_string * s2 = str_retain(s1);
+    INH_string * s3 = str_retain(s1);
+    assert(str_equal(s1, s2));
+#ifdef INH_STRING_REFCOUNT
+    assert(s1 == s2);
+    assert(str_is_shared(s1));
+#endif
+
+    // modifying one owner's String leaves the others alone
+    INH_string * expected = str_new("shared payload");
+    s2 = str_append(s2, '!');
+    s3 = str_to_upper(s3);
+    assert(str_equal(s1, expected));
+    assert(s2->len == s1->len + 1);
+    assert(s3->buffer[0] == 'S');
+
+#ifdef INH_STRING_REFCOUNT
+    // copying into a shared String is refused, even without assert
+    INH_string * s5 = str_retain(s1);
+    assert(str_copy(s5, s3) == 0);
+    assert(str_cat_at(s5, s3, 2) == 2);
+    assert(str_equal(s1, expected));
+    str_release(s5);
+#endif
+
+    // the last owner can modify it in place
+    INH_string * s4 = str_retain(s1);
+    str_release(s1);
+    s4 = str_unshare(s4);
+    assert(!str_is_shared(s4));
+    assert(str_equal(s4, expected));
+
+    str_release(s2);
+    str_release(s3);
+    str_release(s4);
+    free(expected);
+}
+
+void test_str_list (void) {
+    INH_string * name = str_new("newt");
+    INH_string * expected = str_new("{\"name\": \"newt\", \"legs\": 4}");
+    INH_string_list list;
+    str_list_init(&list);
+    assert(str_list_len(&list) == 0);
+
+    str_list_add_view(&list, str_view_cstr("{\"name\": \""));
+    str_list_add(&list, name);
+    str_list_add_view(&list, str_view_cstr("\", \"legs\": "));
+    str_list_add_view(&list, str_view_cstr(""));
+    str_list_add_view(&list, str_view_cstr("4}"));
+    assert(str_list_len(&list) == expected->len);
+
+    INH_string * flat = str_list_flatten(&list);
+    assert(str_equal(flat, expected));
+
+#ifdef INH_STRING__POSIX
+    // enough parts to need more than one writev call
+    int i;
+    for (i = 0; i < 200; i++) {
+	str_list_add(&list, name);
+    }
+    FILE * file = tmpfile();
+    assert(file != NULL);
+    ssize_t written = str_list_writev(&list, fileno(file));
+    assert(written == (ssize_t)str_list_len(&list));
+    rewind(file);
+    INH_string * read_back = str_alloc(written);
+    assert(fread(read_back->buffer, 1, written, file) == (size_t)written);
+    assert(str_equal_sub(read_back, expected, 0, expected->len));
+    assert(read_back->buffer[written - 1] == 't');
+    fclose(file);
+    free(read_back);
+#endif
+
+    str_list_free(&list);
+    free(name);
+    free(expected);
+    free(flat);
+}
+
+/*
+ * Check that a reader splits the text written by test_str_reader.
+ */
+void check_str_reader (INH_string_reader * reader, INH_string * long_line) {
+    INH_view record;
+    char expected[32];
+    int i;
+    for (i = 0; i < 1000; i++) {
+	assert(str_reader_next(reader, &record));
+	snprintf(expected, sizeof(expected), "line %d", i);
+	assert(record.len == strlen(expected));
+	assert(memcmp(record.data, expected, record.len) == 0);
+    }
+    // an empty record, a record longer than a block, and no last delimiter
+    assert(str_reader_next(reader, &record));
+    assert(record.len == 0);
+    assert(str_reader_next(reader, &record));
+    assert(record.len == long_line->len);
+    assert(memcmp(record.data, long_line->buffer, record.len) == 0);
+    assert(str_reader_next(reader, &record));
+    assert(record.len == 4 && memcmp(record.data, "last", 4) == 0);
+    assert(!str_reader_next(reader, &record));
+    assert(!str_reader_error(reader));
+}
+
+void test_str_reader (void) {
+    INH_string * long_line = str_alloc(1000);
+    memset(long_line->buffer, 'x', long_line->len);
+
+    FILE * file = tmpfile();
+    assert(file != NULL);
+    int i;
+    for (i = 0; i < 1000; i++) {
+	fprintf(file, "line %d\n", i);
+    }
+    fputc('\n', file);
+    str_fprint(long_line, file);
+    fputs("\nlast", file);
+
+    INH_string_reader reader;
+    rewind(file);
+    assert(str_reader_init(&reader, file, '\n', 16));
+    check_str_reader(&reader, long_line);
+    str_reader_free(&reader);
+
+#ifdef INH_STRING__POSIX
+    fflush(file);
+    assert(lseek(fileno(file), 0, SEEK_SET) == 0);
+    assert(str_reader_init_fd(&reader, fileno(file), '\n', 0));
+    check_str_reader(&reader, long_line);
+    str_reader_free(&reader);
+
+    // an unfinished record is not returned after a read error
+    FILE * short_file = tmpfile();
+    assert(short_file != NULL);
+    fputs("a\nbc", short_file);
+    fflush(short_file);
+    int fd = dup(fileno(short_file));
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(str_reader_init_fd(&reader, fd, '\n', 4));
+    INH_view record;
+    assert(str_reader_next(&reader, &record));
+    assert(record.len == 1 && record.data[0] == 'a');
+    close(fd);
+    assert(!str_reader_next(&reader, &record));
+    assert(str_reader_error(&reader));
+    str_reader_free(&reader);
+    fclose(short_file);
+#endif
+
+#ifdef INH_STRING_THREADS
+    rewind(file);
+    assert(str_reader_init(&reader, file, '\n', 16));
+    assert(str_reader_start_read_ahead(&reader));
+    check_str_reader(&reader, long_line);
+    str_reader_free(&reader);
+
+#ifdef INH_STRING__POSIX
+    // no reading ahead from a pipe, where a read could block
+    int pipe_fds[2];
+    assert(pipe(pipe_fds) == 0);
+    assert(str_reader_init_fd(&reader, pipe_fds[0], '\n', 16));
+    assert(!str_reader_start_read_ahead(&reader));
+    assert(write(pipe_fds[1], "one\n", 4) == 4);
+    close(pipe_fds[1]);
+    INH_view piped;
+    assert(str_reader_next(&reader, &piped) && piped.len == 3);
+    assert(!str_reader_next(&reader, &piped) && !str_reader_error(&reader));
+    str_reader_free(&reader);
+    close(pipe_fds[0]);
+#endif
+#endif
+
+    fclose(file);
+    free(long_line);
+}
+
+void test_str_compare (void) {
+    INH_string * s1 = str_new("apple");
+    INH_string * s2 = str_new("apples");
+    INH_string * s3 = str_new("banana");
+    INH_string * s4 = str_new_len("apple\0", 6);
+    INH_string * s5 = str_new("\xff");
+    INH_string * s6 = str_new("");
+
+    assert(str_compare(s1, s1) == 0);
+    assert(str_compare(s1, s2) < 0);
+    assert(str_compare(s2, s1) > 0);
+    assert(str_compare(s2, s3) < 0);
+    assert(str_compare(s1, s4) < 0);
+    assert(str_compare(s4, s2) < 0);
+    assert(str_compare(s3, s5) < 0); // bytes compare as unsigned
+    assert(str_compare(s6, s1) < 0);
+
+    // a difference past the first 16 bytes
+    INH_string * s7 = str_new("a long string that is the same for a while, then x");
+    INH_string * s8 = str_new("a long string that is the same for a while, then y");
+    assert(str_compare(s7, s8) < 0);
+    assert(str_compare(s8, s7) > 0);
+
+    free(s1);
+    free(s2);
+    free(s3);
+    free(s4);
+    free(s5);
+    free(s6);
+    free(s7);
+    free(s8);
+}
+
+int compare_strings (const void * a, const void * b) {
+    return str_compare(*(INH_string * const *)a, *(INH_string * const *)b);
+}
+
+void test_str_sort (void) {
+    // few distinct bytes, so there are many shared prefixes and embedded nulls
+    size_t length = 20000;
+    INH_string ** strings = malloc(length * sizeof(*strings));
+    INH_string ** expected = malloc(length * sizeof(*expected));
+    srand(2);
+    size_t i, j;
+    for (i = 0; i < length; i++) {
+	strings[i] = str_alloc(rand() % 24);
+	for (j = 0; j < strings[i]->len; j++) {
+	    strings[i]->buffer[j] = "\0ab\xff"[rand() % 4];
+	}
+	expected[i] = strings[i];
+    }
+    qsort(expected, length, sizeof(*expected), compare_strings);
+
+    str_sort(strings, length);
+    for (i = 0; i < length; i++) {
+	assert(str_equal(strings[i], expected[i]));
+    }
+
+#ifdef INH_STRING_THREADS
+    for (i = 0; i < length; i++) {
+	INH_string * t = strings[i];
+	j = rand() % length;
+	strings[i] = strings[j];
+	strings[j] = t;
+    }
+    str_sort_parallel(strings, length, 4);
+    for (i = 0; i < length; i++) {
+	assert(str_equal(strings[i], expected[i]));
+    }
+#endif
+
+    for (i = 0; i < length; i++) {
+	free(strings[i]);
+    }
+
+    // already sorted and reversed input, with distinct keys at each depth
+    for (i = 0; i < length; i++) {
+	char key[32];
+	snprintf(key, sizeof(key), "key/%08d/%03d", (int)(i / 7), (int)(i % 7));
+	expected[i] = str_new(key);
+	strings[i] = expected[i];
+    }
+    str_sort(strings, length);
+    for (i = 0; i < length; i++) {
+	assert(strings[i] == expected[i]);
+	strings[i] = expected[length - 1 - i];
+    }
+    str_sort(strings, length);
+    for (i = 0; i < length; i++) {
+	assert(strings[i] == expected[i]);
+    }
+    for (i = 0; i < length; i++) {
+	free(strings[i]);
+    }
+    free(strings);
+    free(expected);
+}
+
+void test_str_builder (void) {
+    INH_string_builder builder;
+    assert(str_builder_init(&builder, 4));
+    INH_string * name = str_new("newt");
+
+    // grows past the initial capacity
+    assert(str_builder_printf(&builder, "%s has %d legs", "a", 4));
+    assert(str_builder_append_char(&builder, ','));
+    assert(str_builder_append_view(&builder, str_view_cstr(" like a ")));
+    assert(str_builder_append(&builder, name));
+    assert(str_builder_printf(&builder, "%c", '.'));
+
+    INH_string * result = str_builder_finish(&builder);
+    INH_string * expected = str_new("a has 4 legs, like a newt.");
+    assert(str_equal(result, expected));
+
+    free(name);
+    free(result);
+    free(expected);
+}
+
+void test_str_builder_escape (void) {
+    INH_string_builder builder;
+    assert(str_builder_init(&builder, 0));
+    assert(str_builder_append_json(&builder, str_view_cstr("plain text that is longer than sixteen")));
+    assert(str_builder_append_char(&builder, ' '));
+    assert(str_builder_append_json(&builder, str_view_cstr("say \"hi\"\\\n\t\x01 caf\xc3\xa9 and then some more text")));
+    INH_string * result = str_builder_finish(&builder);
+    INH_string * expected = str_new("\"plain text that is longer than sixteen\" "
+	    "\"say \\\"hi\\\"\\\\\\n\\t\\u0001 caf\xc3\xa9 and then some more text\"");
+    assert(str_equal(result, expected));
+    free(result);
+    free(expected);
+
+    assert(str_builder_init(&builder, 0));
+    assert(str_builder_append_csv(&builder, str_view_cstr("plain"), ','));
+    assert(str_builder_append_char(&builder, ','));
+    assert(str_builder_append_csv(&builder, str_view_cstr("a field with a comma, that is long"), ','));
+    assert(str_builder_append_char(&builder, ','));
+    assert(str_builder_append_csv(&builder, str_view_cstr("6\" \"ruler\""), ','));
+    assert(str_builder_append_char(&builder, ','));
+    assert(str_builder_append_csv(&builder, str_view_cstr(""), ','));
+    result = str_builder_finish(&builder);
+    expected = str_new("plain,\"a field with a comma, that is long\",\"6\"\" \"\"ruler\"\"\",");
+    assert(str_equal(result, expected));
+    free(result);
+    free(expected);
+}
+
+void test_str_packed (void) {
+    INH_packed_string * p1 = str_packed_new("cheese");
+    assert(str_packed_len(p1) == 6);
+    assert(strcmp(str_packed_cstr(p1), "cheese") == 0);
+    // 1 length byte, 1 flags byte and the null character
+    assert(str_packed_alloc_size(p1) == 6 + 3);
+
+    INH_string * s1 = str_new("cheese");
+    INH_packed_string * p2 = str_packed_from(s1, false);
+    assert(str_packed_cstr(p2) == NULL);
+    assert(str_packed_equal(p1, p2));
+    INH_string * s2 = str_packed_to_string(p2);
+    assert(str_equal(s1, s2));
+
+    // growing past 255 and 65535 characters moves to bigger headers
+    INH_string * long_text = str_alloc(70000);
+    memset(long_text->buffer, 'z', long_text->len);
+    p1 = str_packed_append(p1, '!');
+    p1 = str_packed_cat(p1, str_view_sub(long_text, 0, 300));
+    assert(str_packed_len(p1) == 307);
+    assert(str_packed_alloc_size(p1) == 307 + 4);
+    p1 = str_packed_cat(p1, str_view(long_text));
+    assert(str_packed_len(p1) == 70307);
+    assert(str_packed_alloc_size(p1) == 70307 + 6);
+    const char * c1 = str_packed_cstr(p1);
+    assert(strncmp(c1, "cheese!zzz", 10) == 0);
+    assert(strlen(c1) == 70307);
+
+    INH_packed_string * p3 = str_packed_dup(p1);
+    assert(str_packed_equal(p1, p3));
+    assert(str_packed_compare(p2, p1) < 0);
+    assert(str_packed_compare(p1, p2) > 0);
+    assert(str_packed_compare(p1, p3) == 0);
+
+    // views work with the other functions
+    int64_t n;
+    INH_packed_string * p4 = str_packed_new_len("-42", 3, false);
+    assert(str_parse_int(str_packed_view(p4), &n) == 3);
+    assert(n == -42);
+
+    str_packed_free(p1);
+    str_packed_free(p2);
+    str_packed_free(p3);
+    str_packed_free(p4);
+    free(s1);
+    free(s2);
+    free(long_text);
+}
+
+static const INH_string * const keywords[] = {
+    STR_LITERAL("auto"), STR_LITERAL("break"), STR_LITERAL("case"), STR_LITERAL("char"),
+    STR_LITERAL("const"), STR_LITERAL("continue"), STR_LITERAL("default"), STR_LITERAL("do"),
+    STR_LITERAL("double"), STR_LITERAL("else"), STR_LITERAL("enum"), STR_LITERAL("extern"),
+    STR_LITERAL("float"), STR_LITERAL("for"), STR_LITERAL("goto"), STR_LITERAL("if"),
+    STR_LITERAL("int"), STR_LITERAL("long"), STR_LITERAL("register"), STR_LITERAL("return"),
+    STR_LITERAL("short"), STR_LITERAL("signed"), STR_LITERAL("sizeof"), STR_LITERAL("static"),
+    STR_LITERAL("struct"), STR_LITERAL("switch"), STR_LITERAL("typedef"), STR_LITERAL("union"),
+    STR_LITERAL("unsigned"), STR_LITERAL("void"), STR_LITERAL("volatile"), STR_LITERAL("while"),
+    STR_LITERAL(""), STR_LITERAL("with\0null"),
+};
+
+// keywords written out by str_table_write_c, as "c_keywords"
+#include "c_keywords_table.h"
+
+void test_str_literal (void) {
+    INH_string * s1 = str_new("continue");
+    assert(keywords[5]->len == 8);
+    assert(str_equal(keywords[5], s1));
+    assert(keywords[32]->len == 0);
+    assert(keywords[33]->len == 9);
+
+    // modifying a copy leaves it alone
+    INH_string * s2 = str_dup(keywords[5]);
+    s2 = str_to_upper(s2);
+    assert(str_equal(keywords[5], s1));
+    free(s2);
+
+#ifdef INH_STRING_REFCOUNT
+    // literals are always shared, so modifying functions copy them
+    assert(str_is_shared(keywords[5]));
+    s2 = str_to_upper((INH_string *)keywords[5]);
+    assert(s2 != keywords[5]);
+    assert(str_equal(keywords[5], s1));
+    INH_string * s3 = str_new("CONTINUE");
+    assert(str_equal(s2, s3));
+    assert(str_is_shared(keywords[5]));
+    free(s2);
+    free(s3);
+#endif
+
+    free(s1);
+}
+
+void test_str_table (void) {
+    size_t count = sizeof(keywords) / sizeof(*keywords);
+    INH_string_table table;
+    assert(str_table_build(&table, keywords, count));
+
+    size_t i;
+    for (i = 0; i < count; i++) {
+	assert(str_table_find(&table, str_view(keywords[i])) == (int)i);
+    }
+    assert(str_table_find(&table, str_view_cstr("main")) == -1);
+    assert(str_table_find(&table, str_view_cstr("whilst")) == -1);
+    assert(str_table_find(&table, str_view_cstr("with")) == -1);
+
+    // the table written as C compiles, and finds the same keys
+    assert(c_keywords.slot_count == table.slot_count);
+    assert(c_keywords.bucket_count == table.bucket_count);
+    assert(memcmp(c_keywords.indices, table.indices, table.slot_count * sizeof(*table.indices)) == 0);
+    assert(memcmp(c_keywords.seeds, table.seeds, table.bucket_count * sizeof(*table.seeds)) == 0);
+    for (i = 0; i < count; i++) {
+	assert(str_table_find(&c_keywords, str_view(keywords[i])) == (int)i);
+    }
+    assert(str_table_find(&c_keywords, str_view_cstr("main")) == -1);
+
+    // and is what str_table_write_c writes now
+    FILE * file = tmpfile();
+    assert(file != NULL);
+    assert(str_table_write_c(&table, file, "c_keywords") != EOF);
+    char path[512];
+    const char * dir_end = strrchr(__FILE__, '/');
+    size_t dir_len = (dir_end != NULL) ? (size_t)(dir_end - __FILE__ + 1) : 0;
+    snprintf(path, sizeof(path), "%.*sc_keywords_table.h", (int)dir_len, __FILE__);
+    FILE * expected = fopen(path, "r");
+    assert(expected != NULL);
+    rewind(file);
+    int c;
+    do {
+	c = fgetc(file);
+	assert(c == fgetc(expected));
+    } while (c != EOF);
+    fclose(expected);
+    fclose(file);
+    str_table_free(&table);
+
+    // duplicate keys can't be told apart
+    const INH_string * const duplicates[] = { STR_LITERAL("same"), STR_LITERAL("same") };
+    assert(!str_table_build(&table, duplicates, 2));
+}
+
 int main () {
     test_str_new();
     test_str_convert();
@@ -223,5 +915,21 @@ int main () {
     test_str_sub();
     test_str_cat();
     test_join();
+    test_str_case();
+    test_str_trim();
+    test_str_replace_char();
+    test_str_translate();
+    test_str_append_number();
+    test_str_parse_number();
+    test_str_retain();
+    test_str_list();
+    test_str_reader();
+    test_str_compare();
+    test_str_sort();
+    test_str_builder();
+    test_str_builder_escape();
+    test_str_packed();
+    test_str_literal();
+    test_str_table();
 }
 
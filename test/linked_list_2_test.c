@@ -0,0 +1,168 @@
+#include "../linked_list_2.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+
+/*
+ * Check that a list holds the expected data pointers in order,
+ * and that its links and length agree.
+ */
+void check_list
+(struct LinkedList2 * list, const int * expected, int length)
+{
+	assert(list->length == length);
+	struct LinkedNode2 * element = list->head;
+	struct LinkedNode2 * previous = NULL;
+	int i;
+	for(i = 0; i < length; i++)
+	{
+		assert(element != NULL);
+		assert(element->previous == previous);
+		assert(element->data_pointer == (void *)(intptr_t)expected[i]);
+		previous = element;
+		element = element->next;
+	}
+	assert(element == NULL);
+	assert(list->tail == previous);
+}
+
+struct LinkedList2 * new_list
+(int first, int length)
+{
+	void * data[16];
+	int i;
+	for(i = 0; i < length; i++)
+	{
+		data[i] = (void *)(intptr_t)(first + i);
+	}
+	return linkedlist2_copy_array(data, length);
+}
+
+void test_append_array
+(void)
+{
+	struct LinkedList2 * list = linkedlist2_list_allocate(0);
+	check_list(list, NULL, 0);
+	linkedlist2_append(list, (void *)1);
+	void * data[] = {(void *)2, (void *)3, (void *)4};
+	linkedlist2_append_array(list, data, 3);
+	linkedlist2_append(list, (void *)5);
+	linkedlist2_prepend(list, (void *)0);
+	check_list(list, (int[]){0, 1, 2, 3, 4, 5}, 6);
+
+	void * out[6];
+	assert(linkedlist2_to_array(list, out) == 6);
+	assert(out[0] == (void *)0 && out[3] == (void *)3 && out[5] == (void *)5);
+
+	// nodes from a block can be removed one at a time
+	struct LinkedNode2 * node = linkedlist2_index_get(list, 3);
+	linkedlist2_node_remove(node);
+	list->length--;
+	check_list(list, (int[]){0, 1, 2, 4, 5}, 5);
+
+	struct LinkedList2 * copy = linkedlist2_copy(list);
+	linkedlist2_reverse(copy);
+	check_list(copy, (int[]){5, 4, 2, 1, 0}, 5);
+	linkedlist2_free(copy);
+	linkedlist2_free(list);
+}
+
+void test_concat
+(void)
+{
+	struct LinkedList2 * empty = new_list(1, 0);
+	struct LinkedList2 * list = new_list(1, 3);
+	linkedlist2_concat(empty, list);
+	check_list(empty, (int[]){1, 2, 3}, 3);
+	check_list(list, NULL, 0);
+
+	struct LinkedList2 * more = new_list(4, 2);
+	linkedlist2_concat(empty, more);
+	linkedlist2_concat(empty, list);
+	check_list(empty, (int[]){1, 2, 3, 4, 5}, 5);
+	linkedlist2_free(empty);
+	linkedlist2_free(list);
+	linkedlist2_free(more);
+}
+
+void test_splice
+(void)
+{
+	// between lists, to the head and to the tail
+	struct LinkedList2 * dest = new_list(1, 3);
+	struct LinkedList2 * source = new_list(10, 5);
+	linkedlist2_splice(dest, NULL, source, source->head, source->head->next, 2);
+	check_list(dest, (int[]){10, 11, 1, 2, 3}, 5);
+	check_list(source, (int[]){12, 13, 14}, 3);
+	linkedlist2_splice(dest, dest->tail, source, source->head->next, source->tail, -1);
+	check_list(dest, (int[]){10, 11, 1, 2, 3, 13, 14}, 7);
+	check_list(source, (int[]){12}, 1);
+	linkedlist2_splice(dest, dest->head, source, source->head, source->head, 1);
+	check_list(dest, (int[]){10, 12, 11, 1, 2, 3, 13, 14}, 8);
+	check_list(source, NULL, 0);
+
+	// within one list, from the tail to the head and back
+	linkedlist2_splice(dest, NULL, dest, dest->tail->previous, dest->tail, -1);
+	check_list(dest, (int[]){13, 14, 10, 12, 11, 1, 2, 3}, 8);
+	linkedlist2_splice(dest, dest->tail, dest, dest->head, dest->head, 1);
+	check_list(dest, (int[]){14, 10, 12, 11, 1, 2, 3, 13}, 8);
+	linkedlist2_free(dest);
+	linkedlist2_free(source);
+}
+
+void test_split_at_node
+(void)
+{
+	struct LinkedList2 * list = new_list(1, 4);
+	struct LinkedList2 * rest = linkedlist2_split_at_node(list, list->tail, 3);
+	check_list(list, (int[]){1, 2, 3}, 3);
+	check_list(rest, (int[]){4}, 1);
+	linkedlist2_free(rest);
+
+	rest = linkedlist2_split_at_node(list, list->head, -1);
+	check_list(list, NULL, 0);
+	check_list(rest, (int[]){1, 2, 3}, 3);
+	linkedlist2_free(list);
+
+	list = rest;
+	rest = linkedlist2_split_at_node(list, list->head, 0);
+	check_list(list, NULL, 0);
+	check_list(rest, (int[]){1, 2, 3}, 3);
+	linkedlist2_free(list);
+	linkedlist2_free(rest);
+}
+
+void * free_list
+(void * list)
+{
+	linkedlist2_free(list);
+	return NULL;
+}
+
+void test_free_threads
+(void)
+{
+	// halves of one block freed by different threads at once
+	int round;
+	for(round = 0; round < 200; round++)
+	{
+		void * data[64] = {NULL};
+		struct LinkedList2 * list = linkedlist2_copy_array(data, 64);
+		struct LinkedList2 * rest = linkedlist2_split_at_node(list, linkedlist2_index_get(list, 32), 32);
+		pthread_t thread;
+		assert(pthread_create(&thread, NULL, free_list, rest) == 0);
+		linkedlist2_free(list);
+		pthread_join(thread, NULL);
+	}
+}
+
+int main
+()
+{
+	test_append_array();
+	test_concat();
+	test_splice();
+	test_split_at_node();
+	test_free_threads();
+}